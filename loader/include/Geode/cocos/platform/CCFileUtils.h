@@ -299,7 +299,8 @@ public:
     void GEODE_DLL addPriorityPath(const char* path);
     /**
      * Update search path order; texture packs are added first, then other  
-     * paths
+     * paths. Also makes the resource index used by fullPathForFilename be 
+     * rebuilt on the next lookup
      * @note Geode addition
      */
     void GEODE_DLL updatePaths();
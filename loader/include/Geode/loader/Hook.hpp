@@ -11,6 +11,7 @@
 namespace geode {
     class Mod;
     class Loader;
+    class HookProfiler;
 
     class GEODE_DLL Hook final {
     private:
@@ -21,6 +22,7 @@ namespace geode {
 
         friend class Mod;
         friend class Loader;
+        friend class HookProfiler;
 
     public:
 
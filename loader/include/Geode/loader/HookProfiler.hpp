@@ -0,0 +1,139 @@
+#pragma once
+
+#include "../DefaultInclude.hpp"
+#include "../utils/Result.hpp"
+#include <matjson.hpp>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace geode {
+    class Hook;
+    class Mod;
+
+    /**
+     * Opt-in profiler for hook detours, for finding out which mods' hooks
+     * are eating up frame time. Enabled by launching the game with the
+     * `--geode:profile-hooks` launch flag.
+     * Only detours created through `$modify` in mods built with
+     * `GEODE_HOOK_PROFILING` defined (the `GEODE_HOOK_PROFILING` CMake
+     * option) are profiled; other mods' detours don't contain any
+     * profiling code at all.
+     * While enabled, the results are shown in an overlay and written to the
+     * logs directory whenever the game saves
+     */
+    class GEODE_DLL HookProfiler final {
+    public:
+        struct HookStats final {
+            Hook* hook;
+            Mod* mod;
+            std::string name;
+            uint64_t calls = 0;
+            /**
+             * Time spent in the detour, including any hooks it called into
+             * (such as the next detour in the chain when calling the original)
+             */
+            std::chrono::nanoseconds inclusiveTime {};
+            /**
+             * Time spent in the detour itself, excluding any hooks it called
+             */
+            std::chrono::nanoseconds exclusiveTime {};
+        };
+        struct ModStats final {
+            Mod* mod;
+            uint64_t calls = 0;
+            /**
+             * Time spent in any of the mod's detours, including any hooks 
+             * they called into. Time spent in one of the mod's detours while 
+             * another one of them is running is only counted once
+             */
+            std::chrono::nanoseconds inclusiveTime {};
+            /**
+             * Time spent in the mod's detours themselves, excluding any 
+             * hooks they called
+             */
+            std::chrono::nanoseconds exclusiveTime {};
+        };
+
+        /**
+         * Check if hook profiling is enabled for this session
+         */
+        static bool isEnabled();
+
+        /**
+         * Get the accumulated stats for every profiled hook that has been
+         * called, sorted by exclusive time (highest first)
+         */
+        static std::vector<HookStats> getHookStats();
+        /**
+         * Get the accumulated stats of every mod's hooks, sorted by
+         * exclusive time (highest first)
+         */
+        static std::vector<ModStats> getModStats();
+        /**
+         * Discard all the stats collected so far
+         */
+        static void reset();
+
+        /**
+         * Get the collected stats as JSON
+         */
+        static matjson::Value toJSON();
+        /**
+         * Get the collected call stacks in the folded stack format used by
+         * flamegraph tools, with sample counts in microseconds
+         */
+        static std::string toFoldedStacks();
+        /**
+         * Write the collected stats to `hook-profile.json` and
+         * `hook-profile.folded` in the given directory
+         */
+        static Result<> save(std::filesystem::path const& dir);
+
+        /**
+         * Show or hide the overlay listing the most expensive hooks of the
+         * last frame. Does nothing if profiling isn't enabled
+         */
+        static void setOverlayVisible(bool visible);
+
+        // Used by ProfileScope
+        static void enter(void* detour);
+        static void exit();
+    };
+
+    namespace hook {
+        /**
+         * Records a call to a detour for `HookProfiler` for as long as it's
+         * alive. Used by the detours generated by `$modify`
+         */
+        class ProfileScope final {
+        private:
+            bool m_active;
+
+        public:
+            ProfileScope(void* detour) {
+                static bool const enabled = HookProfiler::isEnabled();
+                m_active = enabled;
+                if (m_active) {
+                    HookProfiler::enter(detour);
+                }
+            }
+            ~ProfileScope() {
+                if (m_active) {
+                    HookProfiler::exit();
+                }
+            }
+
+            ProfileScope(ProfileScope const&) = delete;
+            ProfileScope& operator=(ProfileScope const&) = delete;
+        };
+    }
+}
+
+#ifdef GEODE_HOOK_PROFILING
+    #define GEODE_HOOK_PROFILE_SCOPE(detour_) \
+        geode::hook::ProfileScope profileScope(reinterpret_cast<void*>(detour_))
+#else
+    #define GEODE_HOOK_PROFILE_SCOPE(detour_) static_cast<void>(0)
+#endif
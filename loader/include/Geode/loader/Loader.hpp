@@ -9,6 +9,7 @@
 #include "Types.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <matjson.hpp>
 #include <mutex>
 #include <optional>
@@ -17,6 +18,53 @@
 namespace geode {
     using ScheduledFunction = utils::MiniFunction<void()>;
 
+    /**
+     * The order in which functions queued with `queueInMainThread` run 
+     * within a frame
+     */
+    enum class MainThreadPriority : uint8_t {
+        /**
+         * Runs before everything else and is never deferred by the queue's 
+         * time budget. Use for work whose latency is noticeable to the user, 
+         * such as reacting to input
+         */
+        High,
+        Normal,
+        /**
+         * Runs after everything else queued for the frame
+         */
+        Low,
+    };
+
+    /**
+     * Metrics about the main thread queue, as of the last frame
+     */
+    struct MainThreadQueueStats final {
+        /**
+         * Number of functions waiting to run
+         */
+        size_t pending = 0;
+        /**
+         * Number of functions that ran on the last frame
+         */
+        size_t executed = 0;
+        /**
+         * Number of functions that were deferred to the next frame on the 
+         * last frame because the time budget ran out
+         */
+        size_t deferred = 0;
+        /**
+         * Time spent running queued functions on the last frame
+         */
+        std::chrono::microseconds time {};
+        /**
+         * Average and longest time between a function being queued and it 
+         * running, out of the functions that ran on the last frame
+         */
+        std::chrono::microseconds averageLatency {};
+        std::chrono::microseconds maxLatency {};
+    };
+
     struct InvalidGeodeFile {
         std::filesystem::path path;
         std::string reason;
@@ -141,6 +189,19 @@ namespace geode {
         }
 
         void queueInMainThread(ScheduledFunction&& func);
+        /**
+         * Queue a function to run on the main thread with the given priority
+         */
+        void queueInMainThread(ScheduledFunction&& func, MainThreadPriority priority);
+        /**
+         * Limit how long the main thread queue may run for on a single frame. 
+         * Once the budget is used up, remaining functions (other than 
+         * high-priority ones) are deferred to the next frame; at least one 
+         * function runs every frame regardless. By default there is no limit
+         * @param budget The time budget, or nullopt to remove the limit
+         */
+        void setMainThreadQueueBudget(std::optional<std::chrono::microseconds> budget);
+        MainThreadQueueStats getMainThreadQueueStats() const;
 
         /**
          * Returns the current game version.
@@ -161,6 +222,15 @@ namespace geode {
     inline GEODE_HIDDEN void queueInMainThread(ScheduledFunction&& func) {
         Loader::get()->queueInMainThread(std::forward<ScheduledFunction>(func));
     }
+    /**
+     * @brief Queues a function to run on the main thread
+     * 
+     * @param func the function to queue
+     * @param priority when the function should run relative to others
+    */
+    inline GEODE_HIDDEN void queueInMainThread(ScheduledFunction&& func, MainThreadPriority priority) {
+        Loader::get()->queueInMainThread(std::forward<ScheduledFunction>(func), priority);
+    }
 
     /**
      * @brief Take the next mod to load
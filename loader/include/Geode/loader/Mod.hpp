@@ -283,7 +283,26 @@ namespace geode {
             return Loader::get()->parseLaunchArgument<T>(this->getLaunchArgumentName(name));
         }
 
+        /**
+         * Get the container of saved values. As there's no telling whether 
+         * it's modified through the returned reference, the saved values are 
+         * serialized again the next time the game saves, and only written if 
+         * they differ from what was last written. Prefer `getSavedValues` 
+         * for reading and `getMutableSavedValues` or `setSavedValue` for 
+         * writing
+         */
         matjson::Value& getSaveContainer();
+        /**
+         * Get the container of saved values for modifying it. This marks the 
+         * saved values as changed, so they get written the next time the game 
+         * saves
+         */
+        matjson::Value& getMutableSavedValues();
+        /**
+         * Get the container of saved values for reading. Unlike 
+         * `getSaveContainer`, this doesn't mark the saved values as changed
+         */
+        matjson::Value const& getSavedValues();
         matjson::Value& getSavedSettingsData();
 
         /**
@@ -301,6 +320,21 @@ namespace geode {
             return T();
         }
 
+        /**
+         * Get a handle to the value of a setting, for reading it in hot code 
+         * paths without having to look the setting up by its key every time. 
+         * The handle stays up-to-date with the setting's value
+         * @param key The key of the setting as defined in `mod.json`
+         * @returns A handle to the setting. If the setting doesn't exist or 
+         * isn't of type `T`, the handle is empty and always reads the default 
+         * value of `T`
+         */
+        template <class T>
+        SettingHandle<T> getSettingHandle(std::string_view const key) const {
+            using S = typename SettingTypeForValueType<T>::SettingType;
+            return SettingHandle<T>(cast::typeinfo_pointer_cast<S>(this->getSettingV3(key)));
+        }
+
         template <class T>
         T setSettingValue(std::string_view const key, T const& value) {
             using S = typename SettingTypeForValueType<T>::SettingType;
@@ -317,7 +351,7 @@ namespace geode {
         template <class T>
         T getSavedValue(std::string_view const key) {
             static_assert(geode::typeImplementsIsJSON<T>(), "T must implement is_json in matjson::Serialize<T>, otherwise this always returns default value.");
-            auto& saved = this->getSaveContainer();
+            auto& saved = this->getSavedValues();
             if (saved.contains(key)) {
                 if (auto value = saved.try_get<T>(key)) {
                     return *value;
@@ -329,13 +363,13 @@ namespace geode {
         template <class T>
         T getSavedValue(std::string_view const key, T const& defaultValue) {
             static_assert(geode::typeImplementsIsJSON<T>(), "T must implement is_json in matjson::Serialize<T>, otherwise this always returns default value.");
-            auto& saved = this->getSaveContainer();
+            auto& saved = this->getSavedValues();
             if (saved.contains(key)) {
                 if (auto value = saved.try_get<T>(key)) {
                     return *value;
                 }
             }
-            saved[key] = defaultValue;
+            this->getMutableSavedValues()[key] = defaultValue;
             return defaultValue;
         }
 
@@ -348,7 +382,7 @@ namespace geode {
          */
         template <class T>
         T setSavedValue(std::string_view const key, T const& value) {
-            auto& saved = this->getSaveContainer();
+            auto& saved = this->getMutableSavedValues();
             auto old = this->getSavedValue<T>(key);
             saved[key] = value;
             return old;
@@ -437,6 +471,19 @@ namespace geode {
             return Ok(ptr);
         }
 
+        /**
+         * Write multiple patches at once. The patches are checked for 
+         * overlaps with each other and with existing patches before any of 
+         * them are written, and if writing one of them fails, the ones 
+         * written before it are reverted, so either all of the patches are 
+         * applied or none are
+         * @param patches The addresses to write into and the data to write 
+         * there
+         * @returns The created patches in the same order as they were 
+         * given, or an error if any of them couldn't be applied
+         */
+        Result<std::vector<Patch*>> patchMany(std::vector<std::pair<void*, ByteVector>> const& patches);
+
         /**
          * Claims an existing patch object, marking this mod as its owner.
          * If the patch has "auto enable" set, this will enable the patch.
@@ -16,6 +16,7 @@ namespace geode {
         friend class ::geode::Mod;
 
         void markRestartRequired();
+        void markChanged();
 
     public:
         static ModSettingsManager* from(Mod* mod);
@@ -69,5 +70,10 @@ namespace geode {
          * has been altered
          */
         bool restartRequired() const;
+        /**
+         * Returns true if any setting has changed (or the savedata has been 
+         * accessed through `getSaveData()`) since the last call to `save()`
+         */
+        bool hasUnsavedChanges() const;
     };
 }
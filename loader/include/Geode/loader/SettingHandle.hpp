@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+
+namespace geode {
+    template <class T>
+    struct SettingTypeForValueType;
+
+    /**
+     * A resolved reference to the value of a setting, for reading settings in 
+     * hot code paths such as per-frame hooks. Unlike `Mod::getSettingValue`, 
+     * reading through a handle involves no lookups, allocations or casts - 
+     * the handle points directly to the setting's value, so it is always 
+     * up-to-date with the latest change. Get one using 
+     * `Mod::getSettingHandle`, for example in `$on_mod(Loaded)`
+     * @tparam T The value type of the setting, such as `bool` or `int64_t`
+     * @tparam S The type of the setting, which is looked up through 
+     * `SettingTypeForValueType` by default
+     */
+    template <class T, class S = typename SettingTypeForValueType<T>::SettingType>
+    class SettingHandle final {
+    public:
+        using SettingType = S;
+
+    private:
+        static inline T const s_default = T();
+
+        std::shared_ptr<SettingType> m_setting;
+        T const* m_value;
+
+    public:
+        /**
+         * Create a handle that doesn't refer to any setting; reading it 
+         * always returns the default value of `T`
+         */
+        SettingHandle() : m_value(&s_default) {}
+        SettingHandle(std::shared_ptr<SettingType> setting)
+          : m_setting(setting),
+            m_value(setting ? &setting->getValueRef() : &s_default)
+        {}
+
+        /**
+         * Get the current value of the setting, or the default value of `T` 
+         * if this handle doesn't refer to a setting
+         */
+        T const& get() const {
+            return *m_value;
+        }
+        T const& operator*() const {
+            return *m_value;
+        }
+        T const* operator->() const {
+            return m_value;
+        }
+
+        /**
+         * Check if this handle refers to an actual setting
+         */
+        explicit operator bool() const {
+            return m_setting != nullptr;
+        }
+        std::shared_ptr<SettingType> getSetting() const {
+            return m_setting;
+        }
+    };
+}
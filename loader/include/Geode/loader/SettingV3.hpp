@@ -9,6 +9,7 @@
 // this unfortunately has to be included because of C++ templates
 #include "../utils/JsonValidation.hpp"
 #include "../utils/function.hpp"
+#include "SettingHandle.hpp"
 
 // todo in v4: this can be removed as well as the friend decl in LegacyCustomSettingV3
 class LegacyCustomSettingToV3Node;
@@ -164,6 +165,13 @@ namespace geode {
          * Check if this setting should be enabled based on the "enable-if" scheme
          */
         bool shouldEnable() const;
+        /**
+         * Get the keys of the settings in this setting's mod that its 
+         * "enable-if" scheme depends on, i.e. the settings whose value can 
+         * change whether this setting is enabled. Saved values and settings 
+         * from other mods are not included
+         */
+        std::vector<std::string> getEnableIfDependencies() const;
         std::optional<std::string> getEnableIfDescription() const;
         /**
          * Whether this setting requires a restart on change
@@ -297,6 +305,14 @@ namespace geode {
         T getValue() const {
             return m_impl->value;
         }
+        /**
+         * Get a reference to the current value of this setting. The 
+         * reference stays valid for as long as the setting exists, and 
+         * always reflects the setting's current value
+         */
+        T const& getValueRef() const {
+            return m_impl->value;
+        }
         /**
          * Set the value of this setting. This will broadcast a new 
          * SettingChangedEventV3, letting any listeners now the value has changed
@@ -711,11 +727,20 @@ namespace geode {
         class Impl;
         std::shared_ptr<Impl> m_impl;
     
+    protected:
+        EventListenerPool* getPool() const override;
+
     public:
         SettingChangedEventV3(std::shared_ptr<SettingV3> setting);
 
         std::shared_ptr<SettingV3> getSetting() const;
     };
+    /**
+     * Listens for changes to a specific setting, or all settings of a mod. 
+     * These listeners are kept in their own pool indexed by mod ID and 
+     * setting key, so a change to a setting only wakes up the listeners that 
+     * are actually interested in it
+     */
     class GEODE_DLL SettingChangedFilterV3 final : public EventFilter<SettingChangedEventV3> {
     private:
         class Impl;
@@ -725,6 +750,12 @@ namespace geode {
         using Callback = void(std::shared_ptr<SettingV3>);
 
         ListenerResult handle(utils::MiniFunction<Callback> fn, SettingChangedEventV3* event);
+        EventListenerPool* getPool() const;
+        void setListener(EventListenerProtocol* listener);
+
+        std::string const& getModID() const;
+        std::optional<std::string> const& getSettingKey() const;
+
         /**
          * Listen to changes on a setting, or all settings
          * @param modID Mod whose settings to listen to
@@ -738,6 +769,44 @@ namespace geode {
         SettingChangedFilterV3(SettingChangedFilterV3 const&);
     };
 
+    /**
+     * Posted once per frame for each mod whose settings have changed during 
+     * that frame, with every setting that changed. Useful for reacting to 
+     * bulk changes (such as the user resetting all settings of a mod) only 
+     * once, instead of once per setting like `SettingChangedEventV3`
+     */
+    class GEODE_DLL SettingsCommittedEventV3 final : public Event {
+    private:
+        class Impl;
+        std::shared_ptr<Impl> m_impl;
+
+    public:
+        SettingsCommittedEventV3(std::string const& modID, std::vector<std::shared_ptr<SettingV3>> const& settings);
+
+        std::string getModID() const;
+        /**
+         * Get the settings that changed, in the order they were first changed. 
+         * Each setting is only listed once, even if it changed multiple times
+         */
+        std::vector<std::shared_ptr<SettingV3>> const& getSettings() const;
+    };
+    class GEODE_DLL SettingsCommittedFilterV3 final : public EventFilter<SettingsCommittedEventV3> {
+    private:
+        std::string m_modID;
+
+    public:
+        using Callback = void(std::vector<std::shared_ptr<SettingV3>> const&);
+
+        ListenerResult handle(utils::MiniFunction<Callback> fn, SettingsCommittedEventV3* event);
+        /**
+         * Listen to batched changes to a mod's settings
+         * @param modID Mod whose settings to listen to
+         */
+        SettingsCommittedFilterV3(std::string const& modID);
+        SettingsCommittedFilterV3(Mod* mod = getMod());
+        SettingsCommittedFilterV3(SettingsCommittedFilterV3 const&);
+    };
+
     class GEODE_DLL SettingNodeSizeChangeEventV3 : public Event {
     private:
         class Impl;
@@ -2,6 +2,7 @@
 #include "../utils/addresser.hpp"
 #include "Traits.hpp"
 #include "../loader/Log.hpp"
+#include "../loader/HookProfiler.hpp"
 
 namespace geode::modifier {
 /**
@@ -15,12 +16,14 @@ namespace geode::modifier {
         template <class Return, class... Params>                                                  \
         struct Impl<Return (*)(Params...)> {                                                      \
             static Return GEODE_CDECL_CALL function(Params... params) {                           \
+                GEODE_HOOK_PROFILE_SCOPE(&function);                                              \
                 return Class2::FunctionName_(params...);                                          \
             }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...)> {                                               \
             static Return GEODE_CDECL_CALL function(Class* self, Params... params) {              \
+                GEODE_HOOK_PROFILE_SCOPE(&function);                                              \
                 auto self2 = addresser::rthunkAdjust(                                             \
                     Resolve<Params...>::func(&Class2::FunctionName_), self                        \
                 );                                                                                \
@@ -30,6 +33,7 @@ namespace geode::modifier {
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...) const> {                                         \
             static Return GEODE_CDECL_CALL function(Class const* self, Params... params) {        \
+                GEODE_HOOK_PROFILE_SCOPE(&function);                                              \
                 auto self2 = addresser::rthunkAdjust(                                             \
                     Resolve<Params...>::func(&Class2::FunctionName_), self                        \
                 );                                                                                \
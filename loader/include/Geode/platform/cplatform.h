@@ -114,6 +114,18 @@
     #define GEODE_ANDROID64(...)
 #endif
 
+// Plain Linux, which the game doesn't run on. This is only for building the 
+// parts of the loader that are unit tested and benchmarked on the host 
+// (loader/test/unit), so it has to be asked for with GEODE_HOST_BUILD
+#if defined(GEODE_HOST_BUILD) && defined(__linux__) && !defined(__ANDROID__)
+    #define GEODE_IS_HOST
+    #define GEODE_CALL
+    #define GEODE_PLATFORM_NAME "Host"
+    #define GEODE_PLATFORM_EXTENSION ".so"
+    #define GEODE_PLATFORM_SHORT_IDENTIFIER "host"
+    #define GEODE_PLATFORM_SHORT_IDENTIFIER_NOARCH "host"
+#endif
+
 #ifndef GEODE_PLATFORM_NAME
     #error "Unsupported PlatformID!"
 #endif
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstring>
+#include "ItaniumCast.hpp"
+
+namespace geode {
+    struct PlatformInfo {
+        void* m_so;
+    };
+}
@@ -105,6 +105,24 @@
 
     #include "android.hpp"
 
+#elif defined(GEODE_IS_HOST)
+
+    #define GEODE_HIDDEN __attribute__((visibility("hidden")))
+    #define GEODE_INLINE inline __attribute__((always_inline))
+    #define GEODE_VIRTUAL_CONSTEXPR constexpr
+    #define GEODE_NOINLINE __attribute__((noinline))
+
+    // Host builds link the loader's sources statically
+    #define GEODE_DLL
+
+    #define GEODE_API extern "C" __attribute__((visibility("default")))
+    #define GEODE_EXPORT __attribute__((visibility("default")))
+
+    #define GEODE_IS_X64
+    #define GEODE_CDECL_CALL
+
+    #include "host.hpp"
+
 #else
 
     #error "Unsupported Platform!"
@@ -166,4 +166,10 @@ namespace geode {
      * asynchronously
      */
     GEODE_DLL cocos2d::CCNode* createServerModLogo(std::string const& id);
+    /**
+     * Create a logo sprite for a specific version of a mod downloaded from 
+     * the Geode servers. Unlike the other overload, the logo is cached on 
+     * disk, so it doesn't have to be downloaded again until the mod updates
+     */
+    GEODE_DLL cocos2d::CCNode* createServerModLogo(std::string const& id, VersionInfo const& version);
 }
@@ -11,6 +11,9 @@ namespace geode {
         cocos2d::ccColor4B color;
 
         ColorProvidedEvent(std::string const& id, cocos2d::ccColor4B const& color);
+
+    protected:
+        EventListenerPool* getPool() const override;
     };
 
     class GEODE_DLL ColorProvidedFilter final : public EventFilter<ColorProvidedEvent> {
@@ -22,10 +25,51 @@ namespace geode {
 
     public:
         ListenerResult handle(utils::MiniFunction<Callback> fn, ColorProvidedEvent* event);
+        EventListenerPool* getPool() const;
+        void setListener(EventListenerProtocol* listener);
+
+        std::string const& getID() const;
 
         ColorProvidedFilter(std::string const& id);
     };
 
+    /**
+     * Posted once when multiple colors are changed at once through 
+     * `ColorProvider::applyTheme`. Before this event is delivered, a 
+     * `ColorProvidedEvent` is delivered for each of the colors, so 
+     * `ColorProvidedFilter` listeners (including ones from mods built 
+     * against older versions of Geode) keep working. A listener that stops 
+     * the event for one color only stops that color's event; the other 
+     * colors and this event are still delivered
+     */
+    struct GEODE_DLL ColorThemeAppliedEvent final : public Event {
+        std::vector<std::pair<std::string, cocos2d::ccColor4B>> colors;
+
+        ColorThemeAppliedEvent(std::vector<std::pair<std::string, cocos2d::ccColor4B>>&& colors);
+
+    protected:
+        EventListenerPool* getPool() const override;
+    };
+
+    class GEODE_DLL ColorThemeAppliedFilter final : public EventFilter<ColorThemeAppliedEvent> {
+    public:
+        using Callback = void(ColorThemeAppliedEvent*);
+
+        ListenerResult handle(utils::MiniFunction<Callback> fn, ColorThemeAppliedEvent* event);
+        EventListenerPool* getPool() const;
+        void setListener(EventListenerProtocol* listener);
+
+        ColorThemeAppliedFilter() = default;
+    };
+
+    /**
+     * Handle to a color defined in `ColorProvider`. Looking a color up through 
+     * its handle skips hashing and comparing its ID, which is worth it for 
+     * colors that are looked up very often. Handles stay valid for the rest 
+     * of the session
+     */
+    enum class ColorHandle : uint32_t {};
+
     /**
      * GD has a lot of hardcoded colors. In addition, mods may very well also 
      * use hardcoded colors in their UIs, for example for CCLayerColors. This 
@@ -112,6 +156,36 @@ namespace geode {
          * @returns The value of the color, or ccWHITE if the ID doesn't exist
          */
         cocos2d::ccColor3B color3b(std::string const& id) const;
+
+        /**
+         * Get a handle to a color, for looking it up without its ID
+         * @param id The ID of the color
+         * @returns The handle, or nullopt if the ID doesn't exist
+         */
+        std::optional<ColorHandle> handle(std::string const& id) const;
+        /**
+         * Get the current value of a color
+         * @param handle Handle to the color, from `handle`
+         */
+        cocos2d::ccColor4B color(ColorHandle handle) const;
+        /**
+         * Get the current value of a color as a ccColor3B
+         * @param handle Handle to the color, from `handle`
+         */
+        cocos2d::ccColor3B color3b(ColorHandle handle) const;
+
+        /**
+         * Override or reset many colors at once, such as when switching 
+         * themes. This posts a single `ColorThemeAppliedEvent` with all the 
+         * colors that changed. For compatibility, a `ColorProvidedEvent` for 
+         * each color is still delivered as part of it, so listeners for 
+         * `ColorProvidedEvent` that don't filter by ID (such as a plain 
+         * `EventListener<EventFilter<ColorProvidedEvent>>`) run once for each 
+         * color. `ColorProvidedFilter` listeners only run for their own color
+         * @param colors The IDs of the colors and the colors to override them 
+         * with, or nullopt to reset them to their original definition
+         */
+        void applyTheme(std::vector<std::pair<std::string, std::optional<cocos2d::ccColor4B>>> const& colors);
     };
 }
 
@@ -4,10 +4,32 @@
 #include "MiniFunction.hpp"
 #include "../loader/Event.hpp"
 #include "../loader/Loader.hpp"
+#include <chrono>
 #include <mutex>
 #include <string_view>
+#include <vector>
 
 namespace geode {
+    /**
+     * Where the mapping functions passed to `Task::mapOn` are run
+     */
+    enum class TaskExecutor {
+        /**
+         * Run on the main thread when the mapped Task's event is posted, like 
+         * `Task::map`
+         */
+        MainThread,
+        /**
+         * Run right away on whichever thread finishes, progresses or cancels 
+         * the mapped Task; usually the Task's worker thread. This skips a hop 
+         * through the main thread (and thus a frame of latency), and keeps 
+         * heavy work like parsing off of it. The mapping functions must not 
+         * touch anything that is only safe to use on the main thread, such as 
+         * nodes
+         */
+        Background,
+    };
+
     /**
      * Tasks represent an asynchronous operation that will be finished at some 
      * unknown point in the future. Tasks can report their progress, and will 
@@ -138,6 +160,23 @@ namespace geode {
             bool m_finalEventPosted = false;
             std::string m_name;
             std::unique_ptr<ExtraData> m_extraData = nullptr;
+            // Functions registered through `mapOn` that are called directly 
+            // by whichever thread finishes, progresses or cancels this Task. 
+            // They are always called with the mutex unlocked, since they lock 
+            // the mapped Task which may in turn cancel this one
+            struct Continuation final {
+                utils::MiniFunction<void(T*)> onFinished;
+                utils::MiniFunction<void(P*)> onProgress;
+                utils::MiniFunction<void()> onCancelled;
+            };
+            std::vector<std::shared_ptr<Continuation>> m_continuations;
+            std::chrono::steady_clock::duration m_progressInterval = std::chrono::steady_clock::duration::zero();
+            std::chrono::steady_clock::time_point m_lastProgressPosted;
+            // Progress values are coalesced: only the latest value is kept 
+            // and at most one progress event is waiting in the main thread 
+            // queue at any time
+            std::optional<P> m_pendingProgress;
+            bool m_progressQueued = false;
 
             class PrivateMarker final {};
 
@@ -276,16 +315,61 @@ namespace geode {
                     std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
                     handle->m_finalEventPosted = true;
                 });
+                // The value can't change anymore, so it's safe to hand out 
+                // without the lock
+                auto continuations = std::move(handle->m_continuations);
+                auto value = &*handle->m_resultValue;
+                lock.unlock();
+                for (auto& continuation : continuations) {
+                    continuation->onFinished(value);
+                }
             }
         }
         static void progress(std::shared_ptr<Handle> handle, P&& value) {
             if (!handle) return;
             std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
+            if (handle->m_status == Status::Pending && !handle->m_continuations.empty()) {
+                auto continuations = handle->m_continuations;
+                lock.unlock();
+                for (auto& continuation : continuations) {
+                    continuation->onProgress(&value);
+                }
+                lock.lock();
+            }
             if (handle->m_status == Status::Pending) {
-                queueInMainThread([handle, value = std::move(value)]() mutable {
-                    Event::createProgressed(handle, &value).post();
+                // If a progress event is already waiting to be posted, just 
+                // replace its value instead of queueing up another one
+                handle->m_pendingProgress.emplace(std::move(value));
+                if (!handle->m_progressQueued) {
+                    handle->m_progressQueued = true;
+                    queueInMainThread([handle]() mutable {
+                        Task::postPendingProgress(handle);
+                    });
+                }
+            }
+        }
+        static void postPendingProgress(std::shared_ptr<Handle> handle) {
+            std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
+            auto now = std::chrono::steady_clock::now();
+            // If the minimum interval hasn't passed yet, try again next frame. 
+            // If the task has finished or been cancelled though, its final 
+            // event has been queued after this one, so the pending progress 
+            // has to be flushed right now to keep events in order
+            if (
+                handle->m_status == Status::Pending &&
+                now - handle->m_lastProgressPosted < handle->m_progressInterval
+            ) {
+                queueInMainThread([handle]() mutable {
+                    Task::postPendingProgress(handle);
                 });
+                return;
             }
+            handle->m_progressQueued = false;
+            handle->m_lastProgressPosted = now;
+            auto value = std::move(*handle->m_pendingProgress);
+            handle->m_pendingProgress.reset();
+            lock.unlock();
+            Event::createProgressed(handle, &value).post();
         }
         static void cancel(std::shared_ptr<Handle> handle, bool shallow = false) {
             if (!handle) return;
@@ -302,6 +386,11 @@ namespace geode {
                     std::unique_lock<std::recursive_mutex> lock(handle->m_mutex);
                     handle->m_finalEventPosted = true;
                 });
+                auto continuations = std::move(handle->m_continuations);
+                lock.unlock();
+                for (auto& continuation : continuations) {
+                    continuation->onCancelled();
+                }
             }
         }
 
@@ -373,6 +462,20 @@ namespace geode {
         void shallowCancel() {
             Task::cancel(m_handle, true);
         }
+        /**
+         * Set the minimum interval between progress events posted by this 
+         * Task. Progress values reported faster than this are coalesced, so 
+         * listeners only receive the latest one. Regardless of the interval, 
+         * progress is posted at most once per frame, and never after the 
+         * Task's finished or cancelled event
+         * @param interval The minimum interval; zero (the default) means 
+         * progress is posted every frame it changes
+         */
+        void setProgressInterval(std::chrono::milliseconds interval) {
+            if (!m_handle) return;
+            std::unique_lock<std::recursive_mutex> lock(m_handle->m_mutex);
+            m_handle->m_progressInterval = interval;
+        }
         bool isPending() const {
             return m_handle && m_handle->is(Status::Pending);
         }
@@ -674,6 +777,118 @@ namespace geode {
             return this->map(std::move(resultMapper), +[](P* p) -> P { return *p; }, name);
         }
 
+        /**
+         * Create a new Task that maps the values of this Task using the 
+         * provided functions, running them on the given executor. With 
+         * `TaskExecutor::MainThread` this is the same as `map`; with 
+         * `TaskExecutor::Background` the functions are called as soon as 
+         * this Task reports a value, on the thread that reported it, so a 
+         * chain of background maps only hops to the main thread once to 
+         * deliver the final value to its listeners.
+         * The new Task takes (shared) ownership of this Task, so the new Task 
+         * may very well be its only owner
+         * @param executor Where to run the mapping functions
+         * @param resultMapper Function that converts the finished values of 
+         * the mapped Task to a desired type. Note that the function is only 
+         * given a pointer to the finish value, as `T` is not guaranteed to be 
+         * copyable - the mapper may NOT move out of the value!
+         * @param progressMapper Function that converts the progress values of 
+         * the mapped Task to a desired type
+         * @param onCancelled Function that is called if the mapped Task is 
+         * cancelled
+         * @param name The name of the Task; used for debugging. The name of 
+         * the mapped task is appended to the end
+         */
+        template <class ResultMapper, class ProgressMapper, class OnCancelled>
+        auto mapOn(
+            TaskExecutor executor, ResultMapper&& resultMapper, ProgressMapper&& progressMapper,
+            OnCancelled&& onCancelled, std::string_view const name = "<Mapping Task>"
+        ) const {
+            if (executor == TaskExecutor::MainThread) {
+                return this->map(std::move(resultMapper), std::move(progressMapper), std::move(onCancelled), name);
+            }
+
+            using T2 = decltype(resultMapper(std::declval<T*>()));
+            using P2 = decltype(progressMapper(std::declval<P*>()));
+
+            Task<T2, P2> task = Task<T2, P2>::Handle::create(fmt::format("{} <= {}", name, m_handle->m_name));
+
+            std::unique_lock<std::recursive_mutex> lock(m_handle->m_mutex);
+
+            // If this task has already been cancelled or finished, map it right away
+            if (m_handle->m_status == Status::Cancelled) {
+                onCancelled();
+                Task<T2, P2>::cancel(task.m_handle);
+            }
+            else if (m_handle->m_status == Status::Finished) {
+                Task<T2, P2>::finish(task.m_handle, std::move(resultMapper(&*m_handle->m_resultValue)));
+            }
+            else {
+                auto continuation = std::make_shared<typename Handle::Continuation>();
+                continuation->onFinished = [
+                    handle = std::weak_ptr(task.m_handle),
+                    resultMapper = std::move(resultMapper)
+                ](T* value) mutable {
+                    // No point in mapping the value if no one is around to receive it
+                    if (auto lock = handle.lock()) {
+                        Task<T2, P2>::finish(lock, std::move(resultMapper(value)));
+                    }
+                };
+                continuation->onProgress = [
+                    handle = std::weak_ptr(task.m_handle),
+                    progressMapper = std::move(progressMapper)
+                ](P* value) mutable {
+                    if (auto lock = handle.lock()) {
+                        Task<T2, P2>::progress(lock, std::move(progressMapper(value)));
+                    }
+                };
+                continuation->onCancelled = [
+                    handle = std::weak_ptr(task.m_handle),
+                    onCancelled = std::move(onCancelled)
+                ]() mutable {
+                    onCancelled();
+                    Task<T2, P2>::cancel(handle.lock());
+                };
+                m_handle->m_continuations.push_back(std::move(continuation));
+
+                // Keep this task alive for as long as the mapped one
+                task.m_handle->m_extraData = std::make_unique<typename Task<T2, P2>::Handle::ExtraData>(
+                    static_cast<void*>(new Task(*this)),
+                    +[](void* ptr) {
+                        delete static_cast<Task*>(ptr);
+                    },
+                    +[](void* ptr) {
+                        // Cancel the mapped task too
+                        static_cast<Task*>(ptr)->cancel();
+                    }
+                );
+            }
+            return task;
+        }
+        /**
+         * Create a new Task that maps the values of this Task using the 
+         * provided functions, running them on the given executor. See the 
+         * other overload of `mapOn` for details
+         */
+        template <class ResultMapper, class ProgressMapper>
+        auto mapOn(
+            TaskExecutor executor, ResultMapper&& resultMapper, ProgressMapper&& progressMapper,
+            std::string_view const name = "<Mapping Task>"
+        ) const {
+            return this->mapOn(executor, std::move(resultMapper), std::move(progressMapper), +[]() {}, name);
+        }
+        /**
+         * Create a new Task that maps the finish value of this Task using the 
+         * provided function, running it on the given executor. Progress is 
+         * mapped by copy-constructing the value as-is. See the other overloads 
+         * of `mapOn` for details
+         */
+        template <class ResultMapper>
+            requires std::copy_constructible<P>
+        auto mapOn(TaskExecutor executor, ResultMapper&& resultMapper, std::string_view const name = "<Mapping Task>") const {
+            return this->mapOn(executor, std::move(resultMapper), +[](P* p) -> P { return *p; }, name);
+        }
+
         /**
          * Creates an implicit event listener for this Task that will call the
          * provided functions when the Task finishes, progresses, or is cancelled.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <inttypes.h>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <type_traits>
@@ -40,6 +40,15 @@ namespace geode::utils::file {
 
     GEODE_DLL Result<> writeString(std::filesystem::path const& path, std::string const& data);
     GEODE_DLL Result<> writeBinary(std::filesystem::path const& path, ByteVector const& data);
+    /**
+     * Write a string to a file atomically: the data is written to a temporary 
+     * file, flushed to disk and then moved over the target, so the target 
+     * always has either its old or its new contents even if the game crashes 
+     * in the middle of writing
+     * @param path Path to the file
+     * @param data Data to write
+     */
+    GEODE_DLL Result<> writeStringSafe(std::filesystem::path const& path, std::string const& data);
 
     template <class T>
     Result<> writeToJson(std::filesystem::path const& path, T const& data) {
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <compare>
+#include <iterator>
 
 namespace geode::utils::string {
     /**
@@ -37,6 +38,91 @@ namespace geode::utils::string {
 
     GEODE_DLL std::vector<std::string> split(std::string const& str, std::string const& split);
 
+    /**
+     * A lazy range over the parts of a string separated by some separator, 
+     * as returned by `splitView`. The parts are views into the original 
+     * string, so it must outlive the range
+     */
+    class SplitView final {
+    public:
+        class Iterator final {
+        private:
+            std::string_view m_rest;
+            std::string_view m_separator;
+            std::string_view m_current;
+            bool m_last = false;
+            bool m_end = false;
+
+            void next() {
+                if (m_last) {
+                    m_end = true;
+                    return;
+                }
+                auto pos = m_separator.empty() ? std::string_view::npos : m_rest.find(m_separator);
+                if (pos == std::string_view::npos) {
+                    m_current = m_rest;
+                    m_last = true;
+                }
+                else {
+                    m_current = m_rest.substr(0, pos);
+                    m_rest.remove_prefix(pos + m_separator.size());
+                }
+            }
+
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() : m_end(true) {}
+            Iterator(std::string_view str, std::string_view separator)
+              : m_rest(str), m_separator(separator), m_end(str.empty())
+            {
+                if (!m_end) this->next();
+            }
+
+            std::string_view operator*() const {
+                return m_current;
+            }
+            Iterator& operator++() {
+                this->next();
+                return *this;
+            }
+            Iterator operator++(int) {
+                auto copy = *this;
+                this->next();
+                return copy;
+            }
+            bool operator==(std::default_sentinel_t) const {
+                return m_end;
+            }
+        };
+
+    private:
+        std::string_view m_str;
+        std::string_view m_separator;
+
+    public:
+        SplitView(std::string_view str, std::string_view separator)
+          : m_str(str), m_separator(separator) {}
+
+        Iterator begin() const {
+            return Iterator(m_str, m_separator);
+        }
+        std::default_sentinel_t end() const {
+            return std::default_sentinel;
+        }
+    };
+
+    /**
+     * Split a string without allocating. Gives the same parts as `split`, 
+     * but as views into `str` that are produced as the range is iterated
+     * @param str String to split; must outlive the returned range
+     * @param separator Separator to split by
+     */
+    inline SplitView splitView(std::string_view str, std::string_view separator) {
+        return SplitView(str, separator);
+    }
+
     GEODE_DLL std::string join(std::vector<std::string> const& strs, std::string const& separator);
 
     GEODE_DLL std::vector<char> split(std::string const& str);
@@ -67,7 +153,16 @@ namespace geode::utils::string {
 
     /**
      * Similar to strcmp, but case insensitive.
-     * Uses std::tolower, but could change in the future for better locale support
+     * Only folds ASCII letters, but could change in the future for better locale support
      */
     GEODE_DLL std::strong_ordering caseInsensitiveCompare(std::string_view a, std::string_view b);
+    /**
+     * Check if two strings are equal ignoring the case of ASCII letters
+     */
+    GEODE_DLL bool caseInsensitiveEquals(std::string_view a, std::string_view b);
+    /**
+     * Hash a string ignoring the case of ASCII letters, so that strings that 
+     * are `caseInsensitiveEquals` hash the same
+     */
+    GEODE_DLL size_t caseInsensitiveHash(std::string_view str);
 }
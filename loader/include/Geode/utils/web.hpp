@@ -83,6 +83,11 @@ namespace geode::utils::web {
 
         std::vector<std::string> headers() const;
         std::optional<std::string> header(std::string_view name) const;
+
+        /**
+         * The URL the response came from, after following any redirects
+         */
+        std::string const& url() const;
     };
 
     class GEODE_DLL WebProgress final {
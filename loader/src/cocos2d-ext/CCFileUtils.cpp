@@ -1,7 +1,12 @@
 
+#include "ResourceIndex.hpp"
+
+#include <Geode/loader/Dirs.hpp>
 #include <Geode/modify/CCFileUtils.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <cocos2d.h>
+#include <algorithm>
+#include <filesystem>
 
 using namespace geode::prelude;
 
@@ -9,6 +14,11 @@ static std::vector<CCTexturePack> REMOVED_PACKS;
 static std::vector<CCTexturePack> PACKS;
 static std::vector<std::string> PATHS;
 
+static ResourceIndex& resourceIndex() {
+    static ResourceIndex inst(dirs::getModRuntimeDir());
+    return inst;
+}
+
 #pragma warning(push)
 #pragma warning(disable : 4273)
 
@@ -88,6 +98,7 @@ void CCFileUtils::updatePaths() {
     // clear old paths
     REMOVED_PACKS.clear();
     m_searchPathArray.clear();
+    resourceIndex().invalidate();
 
     // add texture packs first
     for (auto& pack : PACKS) {
@@ -127,6 +138,20 @@ struct FileUtilsUpdatePaths : Modify<FileUtilsUpdatePaths, CCFileUtils> {
             return filename;
         }
 
+        // The index only knows about plain search paths, so it can't be used 
+        // if cocos' filename remapping or resolution directories are in use
+        bool plainLookup =
+            (!m_pFilenameLookupDict || m_pFilenameLookupDict->count() == 0) &&
+            std::all_of(
+                m_searchResolutionsOrderArray.begin(), m_searchResolutionsOrderArray.end(),
+                [](gd::string const& dir) { return dir.empty(); }
+            );
+        if (plainLookup) {
+            if (auto path = resourceIndex().lookup(m_searchPathArray, filename)) {
+                return gd::string(*path);
+            }
+        }
+
         return CCFileUtils::fullPathForFilename(filename, unk);
     }
 };
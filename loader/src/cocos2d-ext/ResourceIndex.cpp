@@ -0,0 +1,131 @@
+#include "ResourceIndex.hpp"
+
+#include <Geode/utils/string.hpp>
+
+using namespace geode::prelude;
+
+ResourceIndex::ResourceIndex(std::filesystem::path const& immutableRoot)
+  : m_immutableRoot(pathToKey(immutableRoot / "")) {}
+
+std::string ResourceIndex::toKey(std::string str) {
+    // These platforms have case-insensitive file systems by default
+    #if defined(_WIN32) || defined(__APPLE__)
+        utils::string::toLowerIP(str);
+    #endif
+    return str;
+}
+
+std::string ResourceIndex::pathToKey(std::filesystem::path const& path) {
+    #ifdef _WIN32
+        return toKey(utils::string::wideToUtf8(path.generic_wstring()));
+    #else
+        return toKey(path.generic_string());
+    #endif
+}
+
+bool ResourceIndex::canLookUp(std::string_view filename) {
+    // Absolute and relative-to-parent paths aren't looked up in the 
+    // search paths the same way, so leave those to cocos
+    return !(
+        filename.empty() || filename.front() == '/' || filename.starts_with("./") ||
+        (filename.size() > 1 && filename[1] == ':') ||
+        filename.find("..") != std::string_view::npos ||
+        filename.find('\\') != std::string_view::npos
+    );
+}
+
+bool ResourceIndex::isImmutable(std::string const& path) const {
+    auto key = pathToKey(std::filesystem::path(path));
+    return key.size() > m_immutableRoot.size() && key.starts_with(m_immutableRoot);
+}
+
+std::vector<std::string> const& ResourceIndex::scan(std::string const& path) {
+    auto [cached, inserted] = m_directories.try_emplace(path);
+    if (!inserted) {
+        return cached->second;
+    }
+    std::error_code ec;
+    std::filesystem::path dir = path;
+    auto it = std::filesystem::recursive_directory_iterator(
+        dir, std::filesystem::directory_options::skip_permission_denied, ec
+    );
+    for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_regular_file(ec)) {
+            cached->second.push_back(pathToKey(it->path().lexically_relative(dir)));
+        }
+    }
+    return cached->second;
+}
+
+void ResourceIndex::rebuild() {
+    m_valid = true;
+    m_usable = true;
+    m_files.clear();
+    m_unindexed.clear();
+    for (size_t i = 0; i < m_searchPaths.size(); i += 1) {
+        auto& path = m_searchPaths[i];
+        if (!std::filesystem::path(path).is_absolute()) {
+            m_usable = false;
+            return;
+        }
+        if (!this->isImmutable(path)) {
+            m_unindexed.push_back(i);
+            continue;
+        }
+        for (auto& file : this->scan(path)) {
+            m_files.try_emplace(file, i);
+        }
+    }
+}
+
+std::optional<std::string> ResourceIndex::find(std::string_view filename) const {
+    if (!m_usable) {
+        return std::nullopt;
+    }
+
+    auto key = toKey(std::string(filename));
+    // GD may look for a quality-suffixed version of the file first, so 
+    // if a mod has one, let it decide which one to use
+    auto ext = key.find_last_of('.');
+    auto stem = key.substr(0, ext);
+    auto extension = ext == std::string::npos ? std::string() : key.substr(ext);
+    if (m_files.contains(stem + "-hd" + extension) || m_files.contains(stem + "-uhd" + extension)) {
+        return std::nullopt;
+    }
+
+    // Search paths that come before the first mod that has the file 
+    // still need to be checked on disk
+    auto found = m_files.find(key);
+    auto indexed = found != m_files.end() ? found->second : m_searchPaths.size();
+    for (auto i : m_unindexed) {
+        if (i > indexed) {
+            break;
+        }
+        auto path = m_searchPaths[i] + std::string(filename);
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(path, ec)) {
+            return path;
+        }
+    }
+    if (found != m_files.end()) {
+        return m_searchPaths[found->second] + std::string(filename);
+    }
+    // Not in any search path, but cocos may still find it some other 
+    // way, so let it have the final say
+    return std::nullopt;
+}
+
+void ResourceIndex::invalidate() {
+    std::lock_guard lock(m_mutex);
+    m_valid = false;
+}
+
+size_t ResourceIndex::getIndexedFileCount() {
+    std::lock_guard lock(m_mutex);
+    return m_files.size();
+}
+
+size_t ResourceIndex::getUnindexedPathCount() {
+    std::lock_guard lock(m_mutex);
+    return m_unindexed.size();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace geode {
+    // An index of the files in the search paths of extracted mods, so that 
+    // looking up a file doesn't have to stat every mod's search path until 
+    // it's found. Those directories are written once when the mod is 
+    // extracted, before their search path is added, and never change while 
+    // the game is running, so they only need to be scanned once. Every other 
+    // search path (the game's resources, texture packs, the loader's 
+    // resources which the updater writes into) is still checked on disk
+    class ResourceIndex final {
+    private:
+        std::mutex m_mutex;
+        // Search paths in subdirectories of this are the ones that are indexed
+        std::string m_immutableRoot;
+        // Relative file names in each indexed directory. Kept around between 
+        // rebuilds, since paths get added one at a time while mods are loading
+        std::unordered_map<std::string, std::vector<std::string>> m_directories;
+        // File name -> index of the first indexed search path that contains it
+        std::unordered_map<std::string, size_t> m_files;
+        std::vector<std::string> m_searchPaths;
+        // Indices of the search paths that aren't indexed
+        std::vector<size_t> m_unindexed;
+        bool m_valid = false;
+        // Whether every search path is on the filesystem; relative ones (such 
+        // as APK assets on Android) aren't, and then the index can't be used
+        bool m_usable = false;
+
+        static std::string toKey(std::string str);
+        static std::string pathToKey(std::filesystem::path const& path);
+        static bool canLookUp(std::string_view filename);
+
+        bool isImmutable(std::string const& path) const;
+        std::vector<std::string> const& scan(std::string const& path);
+        void rebuild();
+        std::optional<std::string> find(std::string_view filename) const;
+
+        // Search paths are taken as any range of strings so this works with 
+        // both cocos' gd::vector<gd::string> and standard containers
+        template <class SearchPaths>
+        bool isUpToDate(SearchPaths const& searchPaths) const {
+            if (!m_valid || searchPaths.size() != m_searchPaths.size()) {
+                return false;
+            }
+            size_t i = 0;
+            for (auto& path : searchPaths) {
+                if (std::string_view(path) != m_searchPaths[i]) {
+                    return false;
+                }
+                i += 1;
+            }
+            return true;
+        }
+
+    public:
+        // Mods are extracted into their own directory in `immutableRoot` while 
+        // others are already loading, so only the directories of single mods 
+        // can be indexed, not the root itself
+        explicit ResourceIndex(std::filesystem::path const& immutableRoot);
+
+        // Mark the index as outdated, so that it's rebuilt on the next lookup
+        void invalidate();
+
+        // Returns the full path of a file if it was found, or nullopt if the 
+        // lookup has to go through cocos instead
+        template <class SearchPaths>
+        std::optional<std::string> lookup(SearchPaths const& searchPaths, std::string_view filename) {
+            if (!canLookUp(filename)) {
+                return std::nullopt;
+            }
+            std::lock_guard lock(m_mutex);
+            if (!this->isUpToDate(searchPaths)) {
+                m_searchPaths.clear();
+                for (auto& path : searchPaths) {
+                    m_searchPaths.emplace_back(std::string_view(path));
+                }
+                this->rebuild();
+            }
+            return this->find(filename);
+        }
+
+        size_t getIndexedFileCount();
+        size_t getUnindexedPathCount();
+    };
+}
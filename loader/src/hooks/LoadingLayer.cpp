@@ -4,6 +4,7 @@
 #include <array>
 #include <fmt/format.h>
 #include <loader/LoaderImpl.hpp>
+#include <loader/StartupTrace.hpp>
 #include <loader/console.hpp>
 #include <loader/updater.hpp>
 #include <Geode/utils/NodeIDs.hpp>
@@ -84,7 +85,17 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     void setupLoadingMods() {
         if (Loader::get()->getLoadingState() != Loader::LoadingState::Done) {
             this->updateLoadedModsLabel();
-            this->waitLoadAssets();
+            // The loader lets us know whenever it has loaded more mods, so 
+            // there's no need to check on every frame
+            LoaderImpl::get()->addRefreshListener([this]() {
+                if (Loader::get()->getLoadingState() != Loader::LoadingState::Done) {
+                    this->updateLoadedModsLabel();
+                    this->updateLoadingBar();
+                    return;
+                }
+                this->setSmallText2("");
+                this->continueLoadAssets();
+            });
         }
         else {
             this->continueLoadAssets();
@@ -145,8 +156,41 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     void setupModResources() {
         log::debug("Loading mod resources");
         this->setSmallText("Loading mod resources");
-        LoaderImpl::get()->updateResources(true);
-        this->continueLoadAssets();
+        if (!m_fromRefresh) {
+            LoaderImpl::get()->beginLoadingPhase("resources");
+        }
+        LoaderImpl::get()->startLoadingResources(true);
+        this->continueLoadModResources();
+    }
+
+    void continueLoadModResources() {
+        // Spritesheets are decoded in the background; only upload as many 
+        // of them per frame as fits in the budget to keep the screen responsive
+        if (LoaderImpl::get()->continueLoadingResources(std::chrono::milliseconds(12))) {
+            if (!m_fromRefresh) {
+                LoaderImpl::get()->endLoadingPhase();
+                auto res = LoaderImpl::get()->saveLoadingTimeline(dirs::getGeodeLogDir());
+                if (!res) {
+                    log::warn("Unable to save loading timeline: {}", res.unwrapErr());
+                }
+                // The trace ends with the loading timeline, as the rest is 
+                // up to the game
+                if (StartupTrace::isEnabled()) {
+                    auto res = StartupTrace::save(dirs::getGeodeLogDir());
+                    if (!res) {
+                        log::warn("Unable to save startup trace: {}", res.unwrapErr());
+                    }
+                }
+            }
+            this->continueLoadAssets();
+            return;
+        }
+        auto [loaded, total] = LoaderImpl::get()->getResourceLoadProgress();
+        this->setSmallText(fmt::format("Loading mod resources: {}/{}", loaded, total));
+        this->updateLoadingBar();
+        Loader::get()->queueInMainThread([this]() {
+            this->continueLoadModResources();
+        });
     }
 
     int getLoadedMods() {
@@ -163,8 +207,16 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         });
     }
     
-    int getCurrentStep() {
-        return m_fields->m_geodeLoadStep + m_loadStep + getLoadedMods();
+    float getCurrentStep() {
+        float step = m_fields->m_geodeLoadStep + m_loadStep + getLoadedMods();
+        // Fill in the mod resources step gradually as sheets are loaded
+        if (m_fields->m_geodeLoadStep == 2) {
+            auto [loaded, total] = LoaderImpl::get()->getResourceLoadProgress();
+            if (total > 0) {
+                step += static_cast<float>(loaded) / total;
+            }
+        }
+        return step;
     }
 
     int getTotalStep() {
@@ -176,17 +228,19 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         m_sliderBar->setTextureRect({0, 0, length, m_sliderGrooveHeight});
     }
 
-    void waitLoadAssets() {
-        Loader::get()->queueInMainThread([this]() {
-            this->loadAssets();
-        });
+    static char const* getGeodeLoadStepName(int step) {
+        constexpr std::array<char const*, 3> names = {
+            "Loading mods", "Loader resources", "Mod resources",
+        };
+        return step >= 0 && step < static_cast<int>(names.size()) ? names[step] : nullptr;
     }
 
     void continueLoadAssets() {
+        if (auto name = getGeodeLoadStepName(m_fields->m_geodeLoadStep)) {
+            StartupTrace::endSpan("loading-layer", name);
+        }
         ++m_fields->m_geodeLoadStep;
-        Loader::get()->queueInMainThread([this]() {
-            this->loadAssets();
-        });
+        this->loadAssets();
     }
 
     bool skipOnRefresh() {
@@ -198,6 +252,11 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
 
     // hook
     void loadAssets() {
+        // Our steps take multiple frames, so they're traced as spans that 
+        // end in continueLoadAssets
+        if (auto name = getGeodeLoadStepName(m_fields->m_geodeLoadStep)) {
+            StartupTrace::beginSpan("loading-layer", name);
+        }
         switch (m_fields->m_geodeLoadStep) {
         case 0:
             if (this->skipOnRefresh()) this->setupLoadingMods();
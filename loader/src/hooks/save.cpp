@@ -1,4 +1,6 @@
 #include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/HookProfiler.hpp>
 
 using namespace geode::prelude;
 
@@ -18,6 +20,13 @@ namespace {
         auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
         log::info("Took {}s", static_cast<float>(time) / 1000.f);
 
+        if (HookProfiler::isEnabled()) {
+            auto res = HookProfiler::save(dirs::getGeodeLogDir());
+            if (!res) {
+                log::warn("Unable to save hook profile: {}", res.unwrapErr());
+            }
+        }
+
         log::popNest();
     }
 }
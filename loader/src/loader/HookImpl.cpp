@@ -49,10 +49,7 @@ Result<> Hook::Impl::enable() {
         return Ok();
     }
 
-    // During a transition between updates when it's important to get a
-    // non-functional version that compiles, address 0x9999999 is used to mark
-    // functions not yet RE'd but that would prevent compilation
-    if ((uintptr_t)m_address == (geode::base::get() + 0x9999999)) {
+    if (this->hasPlaceholderAddress()) {
         if (m_owner) {
             log::warn(
                 "Hook {} for {} uses placeholder address, refusing to hook",
@@ -66,6 +63,13 @@ Result<> Hook::Impl::enable() {
     }
 
     GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getOrCreateHandler(m_address, m_handlerMetadata));
+    return this->enable(handler);
+}
+
+Result<> Hook::Impl::enable(tulip::hook::HandlerHandle handler) {
+    if (m_enabled) {
+        return Ok();
+    }
     m_handle = tulip::hook::createHook(handler, m_detour, m_hookMetadata);
     m_enabled = true;
 
@@ -79,6 +83,13 @@ Result<> Hook::Impl::enable() {
     return Ok();
 }
 
+bool Hook::Impl::hasPlaceholderAddress() const {
+    // During a transition between updates when it's important to get a
+    // non-functional version that compiles, address 0x9999999 is used to mark
+    // functions not yet RE'd but that would prevent compilation
+    return (uintptr_t)m_address == (geode::base::get() + 0x9999999);
+}
+
 Result<> Hook::Impl::disable() {
     if (!m_enabled)
         return Ok();
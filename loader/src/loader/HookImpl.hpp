@@ -48,8 +48,13 @@ public:
     tulip::hook::HookHandle m_handle = 0;
 
     Result<> enable();
+    // Install this hook on an already resolved handler. Used for installing 
+    // hooks in batches, so this doesn't log every hook
+    Result<> enable(tulip::hook::HandlerHandle handler);
     Result<> disable();
 
+    bool hasPlaceholderAddress() const;
+
     uintptr_t getAddress() const;
     std::string_view getDisplayName() const;
     matjson::Value getRuntimeInfo() const;
@@ -0,0 +1,473 @@
+#include <Geode/loader/HookProfiler.hpp>
+#include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Mod.hpp>
+#include <Geode/ui/SceneManager.hpp>
+#include <Geode/utils/cocos.hpp>
+#include <Geode/utils/file.hpp>
+#include "HookImpl.hpp"
+#include <atomic>
+#include <mutex>
+
+using namespace geode::prelude;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Every distinct call stack of profiled detours gets its own node, so the
+    // results can be exported as flamegraphs as well as per-hook totals
+    struct CallNode final {
+        void* detour;
+        CallNode* parent;
+        uint64_t calls = 0;
+        Clock::duration inclusive {};
+        std::vector<std::unique_ptr<CallNode>> children;
+
+        CallNode(void* detour, CallNode* parent) : detour(detour), parent(parent) {}
+
+        // Add the counts of another tree into this one
+        void merge(CallNode const& other) {
+            calls += other.calls;
+            inclusive += other.inclusive;
+            for (auto& otherChild : other.children) {
+                this->child(otherChild->detour)->merge(*otherChild);
+            }
+        }
+        // Zero the counts while keeping the nodes, so a thread that keeps 
+        // calling the same detours doesn't have to allocate them again
+        void clearCounts() {
+            calls = 0;
+            inclusive = {};
+            for (auto& child : children) {
+                child->clearCounts();
+            }
+        }
+
+        CallNode* child(void* detour) {
+            // Most detours only ever call into a handful of others, so a
+            // linear search is faster than a map here
+            for (auto& child : children) {
+                if (child->detour == detour) {
+                    return child.get();
+                }
+            }
+            children.push_back(std::make_unique<CallNode>(detour, this));
+            return children.back().get();
+        }
+    };
+
+    // The results of one thread that can be read by other threads
+    struct ThreadProfile final {
+        std::mutex mutex;
+        CallNode root = CallNode(nullptr, nullptr);
+    };
+
+    struct Profiles final {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadProfile>> threads;
+        // Incremented by reset(), so threads know to throw away what they 
+        // have recorded locally but not yet published
+        std::atomic<uint64_t> generation = 0;
+
+        static Profiles& get() {
+            static auto inst = new Profiles();
+            return *inst;
+        }
+    };
+
+    // Calls are recorded into a call tree only the thread itself touches, 
+    // so entering and exiting detours doesn't take any locks. Every now and 
+    // then, after an outermost detour returns, the counts are added to the 
+    // thread's ThreadProfile where they can be read
+    struct LocalProfile final {
+        static constexpr auto PUBLISH_INTERVAL = std::chrono::milliseconds(1);
+
+        CallNode root = CallNode(nullptr, nullptr);
+        CallNode* current = &root;
+        std::vector<Clock::time_point> starts;
+        Clock::time_point lastPublished = Clock::now();
+        uint64_t generation = Profiles::get().generation;
+        std::shared_ptr<ThreadProfile> shared = std::make_shared<ThreadProfile>();
+
+        LocalProfile() {
+            std::unique_lock lock(Profiles::get().mutex);
+            Profiles::get().threads.push_back(shared);
+        }
+        ~LocalProfile() {
+            this->publish(true);
+        }
+
+        // If `wait` is false this gives up instead of waiting for a reader 
+        // to be done with the results, and tries again on a later call
+        void publish(bool wait) {
+            std::unique_lock lock(shared->mutex, std::defer_lock);
+            if (wait) {
+                lock.lock();
+            }
+            else if (!lock.try_lock()) {
+                return;
+            }
+            // Checked with the lock held, as reset() clears the results 
+            // after bumping the generation
+            auto generation = Profiles::get().generation.load();
+            if (generation == this->generation) {
+                shared->root.merge(root);
+            }
+            this->generation = generation;
+            root.clearCounts();
+            lastPublished = Clock::now();
+        }
+    };
+
+    LocalProfile& localProfile() {
+        thread_local LocalProfile profile;
+        return profile;
+    }
+
+    struct Totals final {
+        uint64_t calls = 0;
+        Clock::duration inclusive {};
+        Clock::duration exclusive {};
+    };
+
+    // Visit every node of every thread's call tree, along with the detours
+    // of the node's ancestors. The results of other threads may lag behind 
+    // by up to LocalProfile::PUBLISH_INTERVAL
+    void forEachNode(auto&& callback) {
+        localProfile().publish(true);
+
+        std::unique_lock lock(Profiles::get().mutex);
+        auto threads = Profiles::get().threads;
+        lock.unlock();
+
+        std::vector<void*> path;
+        for (auto& thread : threads) {
+            std::unique_lock threadLock(thread->mutex);
+            auto visit = [&](auto& self, CallNode const& node) -> void {
+                callback(node, path);
+                path.push_back(node.detour);
+                for (auto& child : node.children) {
+                    self(self, *child);
+                }
+                path.pop_back();
+            };
+            for (auto& child : thread->root.children) {
+                visit(visit, *child);
+            }
+        }
+    }
+
+    std::unordered_map<void*, Totals> collectTotals() {
+        std::unordered_map<void*, Totals> totals;
+        forEachNode([&](CallNode const& node, std::vector<void*> const& path) {
+            auto& total = totals[node.detour];
+            total.calls += node.calls;
+            // Recursive calls are already included in the outermost call's
+            // inclusive time
+            if (!ranges::contains(path, node.detour)) {
+                total.inclusive += node.inclusive;
+            }
+            auto exclusive = node.inclusive;
+            for (auto& child : node.children) {
+                exclusive -= child->inclusive;
+            }
+            total.exclusive += exclusive;
+        });
+        return totals;
+    }
+
+    struct DetourInfo final {
+        Hook* hook;
+        Mod* mod;
+        std::string name;
+    };
+    std::unordered_map<void*, DetourInfo> collectDetourInfo() {
+        std::unordered_map<void*, DetourInfo> infos;
+        for (auto mod : Loader::get()->getAllMods()) {
+            for (auto hook : mod->getHooks()) {
+                infos.insert({ hook->m_impl->m_detour, DetourInfo {
+                    .hook = hook,
+                    .mod = mod,
+                    .name = std::string(hook->getDisplayName()),
+                }});
+            }
+        }
+        return infos;
+    }
+    std::string nameOf(std::unordered_map<void*, DetourInfo> const& infos, void* detour) {
+        auto info = infos.find(detour);
+        if (info == infos.end()) {
+            return fmt::format("{}", detour);
+        }
+        if (!info->second.mod) {
+            return info->second.name;
+        }
+        return fmt::format("{}::{}", info->second.mod->getID(), info->second.name);
+    }
+
+    // Time spent in any of a mod's detours. A detour called while another 
+    // detour of the same mod is running (such as the mod's next hook in the 
+    // chain when calling the original) is already part of the outer one's 
+    // time, so it's not counted twice
+    std::unordered_map<Mod*, Clock::duration> collectModInclusive(
+        std::unordered_map<void*, DetourInfo> const& infos
+    ) {
+        auto modOf = [&](void* detour) -> Mod* {
+            auto info = infos.find(detour);
+            return info != infos.end() ? info->second.mod : nullptr;
+        };
+        std::unordered_map<Mod*, Clock::duration> res;
+        forEachNode([&](CallNode const& node, std::vector<void*> const& path) {
+            auto mod = modOf(node.detour);
+            if (!ranges::contains(path, [&](void* detour) { return modOf(detour) == mod; })) {
+                res[mod] += node.inclusive;
+            }
+        });
+        return res;
+    }
+
+    std::chrono::nanoseconds toNanos(Clock::duration dur) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(dur);
+    }
+    double toMillis(Clock::duration dur) {
+        return std::chrono::duration<double, std::milli>(dur).count();
+    }
+
+    class HookProfilerOverlay : public CCNode {
+    protected:
+        CCLabelBMFont* m_label;
+        std::unordered_map<void*, Totals> m_lastTotals;
+        std::unordered_map<void*, DetourInfo> m_infos;
+
+        static constexpr size_t TOP_COUNT = 10;
+
+        bool init() override {
+            if (!CCNode::init())
+                return false;
+
+            auto winSize = CCDirector::get()->getWinSize();
+
+            m_label = CCLabelBMFont::create("", "chatFont.fnt");
+            m_label->setAnchorPoint({ 0, 1 });
+            m_label->setScale(.4f);
+            this->addChildAtPosition(m_label, Anchor::TopLeft, ccp(5, -5));
+
+            this->setContentSize(winSize);
+            this->setZOrder(0x7fffffff);
+            this->setID("hook-profiler-overlay"_spr);
+            this->scheduleUpdate();
+
+            return true;
+        }
+
+        void update(float) override {
+            // Stats are cumulative, so diff them against the last frame's
+            auto totals = collectTotals();
+            std::vector<std::pair<void*, Totals>> frame;
+            for (auto& [detour, total] : totals) {
+                auto last = m_lastTotals.find(detour);
+                auto diff = total;
+                if (last != m_lastTotals.end()) {
+                    diff.calls -= last->second.calls;
+                    diff.inclusive -= last->second.inclusive;
+                    diff.exclusive -= last->second.exclusive;
+                }
+                if (diff.calls) {
+                    frame.push_back({ detour, diff });
+                }
+            }
+            m_lastTotals = std::move(totals);
+
+            std::sort(frame.begin(), frame.end(), [](auto const& a, auto const& b) {
+                return a.second.exclusive > b.second.exclusive;
+            });
+            if (frame.size() > TOP_COUNT) {
+                frame.resize(TOP_COUNT);
+            }
+
+            std::string text;
+            for (auto& [detour, diff] : frame) {
+                // New hooks may have been added since the names were fetched
+                if (!m_infos.contains(detour)) {
+                    m_infos = collectDetourInfo();
+                    // Don't look it up again every frame if it's not a hook 
+                    // owned by any mod
+                    m_infos.insert({ detour, DetourInfo {
+                        .hook = nullptr,
+                        .mod = nullptr,
+                        .name = fmt::format("{}", detour),
+                    }});
+                }
+                text += fmt::format(
+                    "{:.3f}ms ({:.3f}ms incl.) x{} {}\n",
+                    toMillis(diff.exclusive), toMillis(diff.inclusive), diff.calls,
+                    nameOf(m_infos, detour)
+                );
+            }
+            m_label->setString(text.c_str());
+        }
+
+    public:
+        static HookProfilerOverlay* create() {
+            auto ret = new HookProfilerOverlay();
+            if (ret && ret->init()) {
+                ret->autorelease();
+                return ret;
+            }
+            CC_SAFE_DELETE(ret);
+            return nullptr;
+        }
+    };
+
+    // Kept alive by SceneManager
+    HookProfilerOverlay* s_overlay = nullptr;
+}
+
+bool HookProfiler::isEnabled() {
+    static bool enabled = Loader::get()->getLaunchFlag("profile-hooks");
+    return enabled;
+}
+
+void HookProfiler::enter(void* detour) {
+    auto& profile = localProfile();
+    profile.current = profile.current->child(detour);
+    profile.starts.push_back(Clock::now());
+}
+
+void HookProfiler::exit() {
+    auto end = Clock::now();
+    auto& profile = localProfile();
+    if (profile.starts.empty() || profile.current == &profile.root) {
+        return;
+    }
+    profile.current->calls += 1;
+    profile.current->inclusive += end - profile.starts.back();
+    profile.starts.pop_back();
+    profile.current = profile.current->parent;
+
+    if (profile.current == &profile.root && end - profile.lastPublished >= LocalProfile::PUBLISH_INTERVAL) {
+        profile.publish(false);
+    }
+}
+
+std::vector<HookProfiler::HookStats> HookProfiler::getHookStats() {
+    auto infos = collectDetourInfo();
+    std::vector<HookStats> res;
+    for (auto& [detour, total] : collectTotals()) {
+        auto info = infos.find(detour);
+        res.push_back(HookStats {
+            .hook = info != infos.end() ? info->second.hook : nullptr,
+            .mod = info != infos.end() ? info->second.mod : nullptr,
+            .name = info != infos.end() ? info->second.name : fmt::format("{}", detour),
+            .calls = total.calls,
+            .inclusiveTime = toNanos(total.inclusive),
+            .exclusiveTime = toNanos(total.exclusive),
+        });
+    }
+    std::sort(res.begin(), res.end(), [](auto const& a, auto const& b) {
+        return a.exclusiveTime > b.exclusiveTime;
+    });
+    return res;
+}
+
+std::vector<HookProfiler::ModStats> HookProfiler::getModStats() {
+    auto inclusive = collectModInclusive(collectDetourInfo());
+    std::vector<ModStats> res;
+    for (auto& hook : getHookStats()) {
+        auto stats = std::find_if(res.begin(), res.end(), [&](auto const& stats) {
+            return stats.mod == hook.mod;
+        });
+        if (stats == res.end()) {
+            res.push_back(ModStats {
+                .mod = hook.mod,
+                .inclusiveTime = toNanos(inclusive[hook.mod]),
+            });
+            stats = std::prev(res.end());
+        }
+        stats->calls += hook.calls;
+        stats->exclusiveTime += hook.exclusiveTime;
+    }
+    std::sort(res.begin(), res.end(), [](auto const& a, auto const& b) {
+        return a.exclusiveTime > b.exclusiveTime;
+    });
+    return res;
+}
+
+void HookProfiler::reset() {
+    // Calls recorded locally by each thread are dropped the next time the 
+    // thread tries to publish them
+    Profiles::get().generation += 1;
+    std::unique_lock lock(Profiles::get().mutex);
+    for (auto& thread : Profiles::get().threads) {
+        std::unique_lock threadLock(thread->mutex);
+        thread->root.children.clear();
+    }
+}
+
+matjson::Value HookProfiler::toJSON() {
+    auto hooks = matjson::Array();
+    for (auto& stats : getHookStats()) {
+        hooks.push_back(matjson::Object {
+            { "name", stats.name },
+            { "mod", stats.mod ? matjson::Value(stats.mod->getID()) : matjson::Value(nullptr) },
+            { "calls", static_cast<double>(stats.calls) },
+            { "inclusive-ns", static_cast<double>(stats.inclusiveTime.count()) },
+            { "exclusive-ns", static_cast<double>(stats.exclusiveTime.count()) },
+        });
+    }
+    auto mods = matjson::Array();
+    for (auto& stats : getModStats()) {
+        mods.push_back(matjson::Object {
+            { "mod", stats.mod ? matjson::Value(stats.mod->getID()) : matjson::Value(nullptr) },
+            { "calls", static_cast<double>(stats.calls) },
+            { "inclusive-ns", static_cast<double>(stats.inclusiveTime.count()) },
+            { "exclusive-ns", static_cast<double>(stats.exclusiveTime.count()) },
+        });
+    }
+    return matjson::Object {
+        { "hooks", hooks },
+        { "mods", mods },
+    };
+}
+
+std::string HookProfiler::toFoldedStacks() {
+    auto infos = collectDetourInfo();
+    std::string res;
+    forEachNode([&](CallNode const& node, std::vector<void*> const& path) {
+        auto exclusive = node.inclusive;
+        for (auto& child : node.children) {
+            exclusive -= child->inclusive;
+        }
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(exclusive).count();
+        if (micros <= 0) {
+            return;
+        }
+        for (auto detour : path) {
+            res += nameOf(infos, detour);
+            res += ';';
+        }
+        res += nameOf(infos, node.detour);
+        res += fmt::format(" {}\n", micros);
+    });
+    return res;
+}
+
+Result<> HookProfiler::save(std::filesystem::path const& dir) {
+    GEODE_UNWRAP(file::writeString(dir / "hook-profile.json", toJSON().dump()));
+    GEODE_UNWRAP(file::writeString(dir / "hook-profile.folded", toFoldedStacks()));
+    return Ok();
+}
+
+void HookProfiler::setOverlayVisible(bool visible) {
+    if (!isEnabled()) {
+        return;
+    }
+    if (visible && !s_overlay) {
+        s_overlay = HookProfilerOverlay::create();
+        SceneManager::get()->keepAcrossScenes(s_overlay);
+    }
+    else if (!visible && s_overlay) {
+        SceneManager::get()->forget(s_overlay);
+        s_overlay->removeFromParent();
+        s_overlay = nullptr;
+    }
+}
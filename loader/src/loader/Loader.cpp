@@ -97,6 +97,18 @@ void Loader::queueInMainThread(ScheduledFunction&& func) {
     return m_impl->queueInMainThread(std::forward<ScheduledFunction>(func));
 }
 
+void Loader::queueInMainThread(ScheduledFunction&& func, MainThreadPriority priority) {
+    return m_impl->queueInMainThread(std::forward<ScheduledFunction>(func), priority);
+}
+
+void Loader::setMainThreadQueueBudget(std::optional<std::chrono::microseconds> budget) {
+    return m_impl->setMainThreadQueueBudget(budget);
+}
+
+MainThreadQueueStats Loader::getMainThreadQueueStats() const {
+    return m_impl->getMainThreadQueueStats();
+}
+
 std::string Loader::getGameVersion() {
     return m_impl->getGameVersion();
 }
@@ -1,12 +1,16 @@
 #include "LoaderImpl.hpp"
 #include <cocos2d.h>
 
+#include "HookImpl.hpp"
 #include "ModImpl.hpp"
 #include "ModMetadataImpl.hpp"
+#include "ModDataStore.hpp"
+#include "StartupTrace.hpp"
 #include "LogImpl.hpp"
 #include "console.hpp"
 
 #include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/HookProfiler.hpp>
 #include <Geode/loader/IPC.hpp>
 #include <Geode/loader/Loader.hpp>
 #include <Geode/loader/Log.hpp>
@@ -77,6 +81,7 @@ Result<> Loader::Impl::setup() {
         this->initLaunchArguments();
         log::popNest();
     }
+    StartupTrace::setEnabled(this->getLaunchFlag("trace-startup"));
 
     // on some platforms, using the crash handler overrides more convenient native handlers
     if (!this->getLaunchFlag("disable-crash-handler")) {
@@ -97,6 +102,13 @@ Result<> Loader::Impl::setup() {
     }
     log::popNest();
 
+    if (HookProfiler::isEnabled()) {
+        log::info("Hook profiling enabled");
+        this->queueInMainThread([] {
+            HookProfiler::setOverlayVisible(true);
+        });
+    }
+
     log::debug("Setting up directories");
     log::pushNest();
     this->createDirectories();
@@ -120,6 +132,19 @@ void Loader::Impl::addSearchPaths() {
 }
 
 void Loader::Impl::updateResources(bool forceReload) {
+    this->startLoadingResources(forceReload);
+    this->continueLoadingResources(std::nullopt);
+}
+
+void Loader::Impl::startLoadingResources(bool forceReload) {
+    // finish whatever was still being loaded first
+    if (m_nextSheetUpload < m_sheetLoads.size()) {
+        this->continueLoadingResources(std::nullopt);
+    }
+    m_sheetLoads.clear();
+    m_nextSheetDecode = 0;
+    m_nextSheetUpload = 0;
+
     log::debug("Adding resources");
     log::pushNest();
     for (auto const& [_, mod] : m_mods) {
@@ -133,6 +158,132 @@ void Loader::Impl::updateResources(bool forceReload) {
     // on every texture reload
     CCFileUtils::get()->updatePaths();
     log::popNest();
+
+    if (m_sheetLoads.empty()) {
+        return;
+    }
+
+#ifdef GEODE_IS_ANDROID
+    // On Android, VolatileTexture holds on to the image of every texture 
+    // created from one so that it can be recreated when the GL context is 
+    // lost, while textures loaded from a file only remember the path. So 
+    // sheets are loaded from their files on the main thread instead
+    for (auto& load : m_sheetLoads) {
+        load.decoded = true;
+    }
+    return;
+#endif
+
+    // Make sure the decoders aren't still running if the game exits while 
+    // loading
+    static bool registeredAtExit = false;
+    if (!std::exchange(registeredAtExit, true)) {
+        std::atexit([]() {
+            LoaderImpl::get()->stopDecodingResources();
+        });
+    }
+    {
+        std::lock_guard lock(m_sheetMutex);
+        m_stopDecodingSheets = false;
+    }
+
+    auto threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_RESOURCE_THREADS);
+    threadCount = std::min(threadCount, m_sheetLoads.size());
+    log::debug("Decoding {} spritesheets on {} threads", m_sheetLoads.size(), threadCount);
+
+    for (size_t i = 0; i < threadCount; i += 1) {
+        m_sheetThreads.emplace_back([this]() {
+            thread::setName("Resource Decoder");
+            while (true) {
+                SpritesheetLoad* load;
+                {
+                    std::lock_guard lock(m_sheetMutex);
+                    if (m_stopDecodingSheets || m_nextSheetDecode >= m_sheetLoads.size()) {
+                        break;
+                    }
+                    load = &m_sheetLoads[m_nextSheetDecode];
+                    m_nextSheetDecode += 1;
+                }
+                // If decoding fails here, the sheet is loaded the normal way 
+                // on the main thread instead, which will report the error
+                Ref<CCImage> image;
+                if (auto data = file::readBinary(load->imagePath)) {
+                    auto bytes = data.unwrap();
+                    auto decoded = new CCImage();
+                    image = decoded;
+                    decoded->release();
+                    if (!decoded->initWithImageData(bytes.data(), bytes.size())) {
+                        image = nullptr;
+                    }
+                }
+                {
+                    std::lock_guard lock(m_sheetMutex);
+                    load->image = std::move(image);
+                    load->decoded = true;
+                }
+                m_sheetCV.notify_all();
+            }
+        });
+    }
+}
+
+bool Loader::Impl::continueLoadingResources(std::optional<std::chrono::milliseconds> budget) {
+    auto begin = std::chrono::steady_clock::now();
+    while (m_nextSheetUpload < m_sheetLoads.size()) {
+        auto& load = m_sheetLoads[m_nextSheetUpload];
+        {
+            std::unique_lock lock(m_sheetMutex);
+            if (!load.decoded) {
+                if (budget) {
+                    return false;
+                }
+                m_sheetCV.wait(lock, [&] { return load.decoded; });
+            }
+        }
+
+        log::debug("Adding sheet {} from {}", load.plist, load.mod->getID());
+        // The texture has to be in the cache before the sprite frames are 
+        // added, so that they pick it up instead of loading it again
+        if (load.image) {
+            CCTextureCache::get()->addUIImage(load.image, load.png.c_str());
+        }
+        else {
+            CCTextureCache::get()->addImage(load.png.c_str(), false);
+        }
+        CCSpriteFrameCache::get()->addSpriteFramesWithFile(load.plist.c_str());
+        load.image = nullptr;
+        m_nextSheetUpload += 1;
+
+        if (
+            budget && m_nextSheetUpload < m_sheetLoads.size() &&
+            std::chrono::steady_clock::now() - begin >= *budget
+        ) {
+            return false;
+        }
+    }
+    for (auto& thread : m_sheetThreads) {
+        thread.join();
+    }
+    m_sheetThreads.clear();
+    return true;
+}
+
+void Loader::Impl::stopDecodingResources() {
+    {
+        std::lock_guard lock(m_sheetMutex);
+        m_stopDecodingSheets = true;
+    }
+    // Sheets already being decoded are finished, but no new ones are started
+    for (auto& thread : m_sheetThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_sheetThreads.clear();
+}
+
+std::pair<size_t, size_t> Loader::Impl::getResourceLoadProgress() {
+    return { m_nextSheetUpload, m_sheetLoads.size() };
 }
 
 std::vector<Mod*> Loader::Impl::getAllMods() {
@@ -168,17 +319,148 @@ bool Loader::Impl::isModVersionSupported(VersionInfo const& target) {
 // Data saving
 
 void Loader::Impl::saveData() {
+    // Only serialize here; the files are written on the writer thread
+    std::vector<std::pair<std::filesystem::path, std::string>> files;
     for (auto& [id, mod] : m_mods) {
-        log::debug("{}", mod->getID());
-        log::pushNest();
-        auto r = mod->saveData();
-        if (!r) {
-            log::warn("Unable to save data for mod \"{}\": {}", mod->getID(), r.unwrapErr());
+        auto modFiles = ModImpl::getImpl(mod)->serializeData();
+        if (modFiles.size()) {
+            log::debug("{} ({} changed files)", mod->getID(), modFiles.size());
         }
-        log::popNest();
+        std::move(modFiles.begin(), modFiles.end(), std::back_inserter(files));
+    }
+    this->queueDataWrites(std::move(files));
+    if (ModDataStore::get().hasPendingChanges()) {
+        this->queueDataStoreFlush();
     }
 }
 
+void Loader::Impl::queueDataWrites(std::vector<std::pair<std::filesystem::path, std::string>>&& files) {
+    if (files.empty()) {
+        return;
+    }
+    {
+        std::lock_guard lock(m_writeMutex);
+        for (auto& [path, data] : files) {
+            m_pendingWrites.insert_or_assign(path, std::move(data));
+        }
+        m_queuedWriteGeneration += 1;
+        this->startDataWriter();
+    }
+    m_writeCV.notify_all();
+}
+
+void Loader::Impl::queueDataStoreFlush() {
+    {
+        std::lock_guard lock(m_writeMutex);
+        m_storeFlushQueued = true;
+        m_queuedWriteGeneration += 1;
+        this->startDataWriter();
+    }
+    m_writeCV.notify_all();
+}
+
+void Loader::Impl::startDataWriter() {
+    if (m_writerStarted) {
+        return;
+    }
+    m_writerStarted = true;
+    std::thread(&Loader::Impl::writeDataLoop, this).detach();
+    // Make sure nothing is lost if the game exits right after saving
+    std::atexit([]() {
+        LoaderImpl::get()->flushDataWrites(SHUTDOWN_FLUSH_TIMEOUT);
+    });
+}
+
+void Loader::Impl::writeDataLoop() {
+    thread::setName("Mod Data Writer");
+    while (true) {
+        bool flushStore;
+        size_t generation;
+        {
+            std::unique_lock lock(m_writeMutex);
+            m_writeCV.wait(lock, [this]() {
+                return !m_callerFlushing && (!m_pendingWrites.empty() || m_storeFlushQueued);
+            });
+            m_activeWrites.swap(m_pendingWrites);
+            flushStore = std::exchange(m_storeFlushQueued, false);
+            generation = m_queuedWriteGeneration;
+        }
+        while (true) {
+            std::filesystem::path path;
+            std::string data;
+            {
+                std::lock_guard lock(m_writeMutex);
+                if (m_activeWrites.empty()) {
+                    break;
+                }
+                auto node = m_activeWrites.extract(m_activeWrites.begin());
+                path = std::move(node.key());
+                data = std::move(node.mapped());
+                m_currentWrite = path;
+            }
+            auto res = file::writeStringSafe(path, data);
+            if (!res) {
+                log::error("Unable to save {}: {}", path, res.unwrapErr());
+            }
+            std::lock_guard lock(m_writeMutex);
+            m_currentWrite = std::nullopt;
+        }
+        // The store is flushed after the files, since data migrated from it 
+        // to JSON files is erased from it only once those have been written. 
+        // That includes any files flushDataWrites took over
+        if (flushStore) {
+            {
+                std::unique_lock lock(m_writeMutex);
+                m_writeCV.wait(lock, [this]() { return !m_callerFlushing; });
+            }
+            auto res = ModDataStore::get().flush();
+            if (!res) {
+                log::error("Unable to save mod data store: {}", res.unwrapErr());
+            }
+        }
+        {
+            std::lock_guard lock(m_writeMutex);
+            m_finishedWriteGeneration = generation;
+        }
+        m_writeCV.notify_all();
+    }
+}
+
+bool Loader::Impl::flushDataWrites(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(m_writeMutex);
+    auto target = m_queuedWriteGeneration;
+    if (m_writeCV.wait_for(lock, timeout, [&]() { return m_finishedWriteGeneration >= target; })) {
+        return true;
+    }
+    // The writer is stuck or, if the game is exiting, may have already been 
+    // killed, so take over the writes it hasn't started. Newer pending 
+    // writes replace active ones to the same file. The file the writer is 
+    // in the middle of stays with it, along with any newer version of it, 
+    // so that the two never write the same file at once
+    auto files = std::move(m_activeWrites);
+    m_activeWrites.clear();
+    for (auto it = m_pendingWrites.begin(); it != m_pendingWrites.end();) {
+        if (it->first == m_currentWrite) {
+            ++it;
+            continue;
+        }
+        files.insert_or_assign(it->first, std::move(it->second));
+        it = m_pendingWrites.erase(it);
+    }
+    m_storeFlushQueued = false;
+    m_callerFlushing = true;
+    lock.unlock();
+    for (auto& [path, data] : files) {
+        (void)file::writeStringSafe(path, data);
+    }
+    (void)ModDataStore::get().flush();
+    lock.lock();
+    m_callerFlushing = false;
+    lock.unlock();
+    m_writeCV.notify_all();
+    return false;
+}
+
 void Loader::Impl::loadData() {
     for (auto& [_, mod] : m_mods) {
         log::debug("{}", mod->getID());
@@ -219,6 +501,8 @@ Mod* Loader::Impl::getLoadedMod(std::string const& id) const {
 }
 
 void Loader::Impl::updateModResources(Mod* mod) {
+    StartupTrace::Scope trace("mod", "Update resources of {}", mod->getID());
+
     if (!mod->isInternal()) {
         // geode.loader resource is stored somewhere else, which is already added anyway
         auto searchPathRoot = dirs::getModRuntimeDir() / mod->getID() / "resources";
@@ -233,12 +517,15 @@ void Loader::Impl::updateModResources(Mod* mod) {
     log::pushNest();
 
     for (auto const& sheet : mod->getMetadata().getSpritesheets()) {
-        log::debug("Adding sheet {}", sheet);
+        log::debug("Queueing sheet {}", sheet);
         auto png = sheet + ".png";
         auto plist = sheet + ".plist";
         auto ccfu = CCFileUtils::get();
 
-        if (png == std::string(ccfu->fullPathForFilename(png.c_str(), false)) ||
+        // File lookups go through CCFileUtils, which isn't thread-safe, so 
+        // the image's path is resolved here for the decoder threads
+        std::string imagePath = ccfu->fullPathForFilename(png.c_str(), false);
+        if (png == imagePath ||
             plist == std::string(ccfu->fullPathForFilename(plist.c_str(), false))) {
             log::warn(
                 R"(The resource dir of "{}" is missing "{}" png and/or plist files)",
@@ -246,8 +533,12 @@ void Loader::Impl::updateModResources(Mod* mod) {
             );
         }
         else {
-            CCTextureCache::get()->addImage(png.c_str(), false);
-            CCSpriteFrameCache::get()->addSpriteFramesWithFile(plist.c_str());
+            m_sheetLoads.push_back({
+                .mod = mod,
+                .png = std::move(png),
+                .plist = std::move(plist),
+                .imagePath = std::move(imagePath),
+            });
         }
     }
 
@@ -275,6 +566,7 @@ void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
 
             log::debug("Found {}", entry.path().filename());
             log::pushNest();
+            StartupTrace::Scope trace("mod", "Queue {}", entry.path().filename().string());
 
             auto res = ModMetadata::createFromGeodeFile(entry.path());
             if (!res) {
@@ -328,6 +620,7 @@ void Loader::Impl::populateModList(std::vector<ModMetadata>& modQueue) {
     for (auto const& metadata : modQueue) {
         log::debug("{} {}", metadata.getID(), metadata.getVersion());
         log::pushNest();
+        StartupTrace::Scope trace("mod", "Set up {}", metadata.getID());
 
         auto mod = new Mod(metadata);
 
@@ -403,20 +696,24 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
     }
 
     m_currentlyLoadingMod = node;
-    m_refreshingModCount += 1;
     m_refreshedModCount += 1;
     m_lateRefreshedModCount += early ? 0 : 1;
 
-    auto unzipFunction = [this, node]() {
+    std::chrono::milliseconds unzipTime {};
+    auto unzipFunction = [this, node, &unzipTime]() {
         log::debug("Unzip");
-        auto res = node->m_impl->unzipGeodeFile(node->getMetadata());
-        return res;
+        return this->waitForModUnzip(node, unzipTime);
     };
 
-    auto loadFunction = [this, node, early]() {
+    auto loadFunction = [this, node, &unzipTime]() {
         if (node->shouldLoad()) {
             log::debug("Load");
+            auto begin = std::chrono::high_resolution_clock::now();
             auto res = node->m_impl->loadBinary();
+            auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - begin
+            );
+            log::debug("Unzip took {}ms, load took {}ms", unzipTime.count(), time.count());
             if (!res) {
                 this->addProblem({
                     LoadProblem::Type::LoadFailed,
@@ -424,12 +721,9 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
                     res.unwrapErr()
                 });
                 log::error("Failed to load binary: {}", res.unwrapErr());
-                m_refreshingModCount -= 1;
                 return;
             }
         }
-
-        m_refreshingModCount -= 1;
     };
 
     {   // version checking
@@ -440,7 +734,6 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
                 reason.value()
             });
             log::error("{}", reason.value());
-            m_refreshingModCount -= 1;
             log::popNest();
             return;
         }
@@ -453,7 +746,6 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
                 res.unwrapErr()
             });
             log::error("{}", res.unwrapErr());
-            m_refreshingModCount -= 1;
             log::popNest();
             return;
         }
@@ -469,53 +761,184 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
                 )
             });
             log::error("Unsupported Geode version: {}", node->getMetadata().getGeodeVersion());
-            m_refreshingModCount -= 1;
             log::popNest();
             return;
         }
     }
 
-    if (early) {
-        auto res = unzipFunction();
-        if (!res) {
-            this->addProblem({
-                LoadProblem::Type::UnzipFailed,
-                node,
-                res.unwrapErr()
-            });
-            log::error("Failed to unzip: {}", res.unwrapErr());
-            m_refreshingModCount -= 1;
-            log::popNest();
-            return;
+    StartupTrace::Scope trace("mod", "Load {}", node->getID());
+
+    // The mod has already been extracted in the background unless it's 
+    // early-loaded and its turn came up before the workers got to it
+    auto res = unzipFunction();
+    if (!res) {
+        this->addProblem({
+            LoadProblem::Type::UnzipFailed,
+            node,
+            res.unwrapErr()
+        });
+        log::error("Failed to unzip: {}", res.unwrapErr());
+        log::popNest();
+        return;
+    }
+    loadFunction();
+    log::popNest();
+}
+
+void Loader::Impl::startUnzippingMods() {
+    m_unzips.clear();
+    m_unzipIndices.clear();
+    m_nextUnzip = 0;
+    m_finishedUnzipCount = 0;
+    m_resumeRefreshAfterUnzip = false;
+    m_newlyUnzippedMods.clear();
+    for (auto mod : m_modsToLoad) {
+        auto metadata = mod->getMetadata();
+        // Don't bother extracting mods that loadModGraph is going to reject 
+        // before it gets to unzipping them anyway
+        if (
+            metadata.m_impl->m_softInvalidReason ||
+            !metadata.checkGameVersion() ||
+            !this->isModVersionSupported(metadata.getGeodeVersion())
+        ) {
+            continue;
         }
-        loadFunction();
+        m_unzipIndices.insert({ mod, m_unzips.size() });
+        m_unzips.push_back({ .mod = mod, .metadata = std::move(metadata) });
     }
-    else {
-        auto nest = log::saveNest();
-        std::thread([=, this]() {
+    if (m_unzips.empty()) {
+        return;
+    }
+
+    auto threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_UNZIP_THREADS);
+    threadCount = std::min(threadCount, m_unzips.size());
+    log::debug("Unzipping {} mods on {} threads", m_unzips.size(), threadCount);
+
+    auto nest = log::saveNest();
+    for (size_t i = 0; i < threadCount; i += 1) {
+        m_unzipThreads.emplace_back([this, nest]() {
             thread::setName("Mod Unzip");
             log::loadNest(nest);
-            auto res = unzipFunction();
-            this->queueInMainThread([=, this]() {
-                auto prevNest = log::saveNest();
-                log::loadNest(nest);
-                if (!res) {
-                    this->addProblem({
-                        LoadProblem::Type::UnzipFailed,
-                        node,
-                        res.unwrapErr()
+            while (true) {
+                ModUnzip* unzip;
+                {
+                    std::lock_guard lock(m_unzipMutex);
+                    if (m_nextUnzip >= m_unzips.size()) {
+                        break;
+                    }
+                    unzip = &m_unzips[m_nextUnzip];
+                    m_nextUnzip += 1;
+                }
+                auto begin = std::chrono::high_resolution_clock::now();
+                auto res = unzip->mod->m_impl->unzipGeodeFile(unzip->metadata);
+                auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - begin
+                );
+                bool resume;
+                {
+                    std::lock_guard lock(m_unzipMutex);
+                    unzip->result = std::move(res);
+                    unzip->time = time;
+                    m_finishedUnzipCount += 1;
+                    m_newlyUnzippedMods.push_back(unzip->mod);
+                    resume = std::exchange(m_resumeRefreshAfterUnzip, false);
+                }
+                m_unzipCV.notify_all();
+                if (resume) {
+                    this->queueInMainThread([this]() {
+                        this->continueRefreshModGraph();
                     });
-                    log::error("Failed to unzip: {}", res.unwrapErr());
-                    m_refreshingModCount -= 1;
-                    log::loadNest(prevNest);
-                    return;
                 }
-                loadFunction();
-                log::loadNest(prevNest);
-            });
-        }).detach();
+            }
+        });
     }
-    log::popNest();
+}
+
+void Loader::Impl::finishUnzippingMods() {
+    for (auto& thread : m_unzipThreads) {
+        thread.join();
+    }
+    m_unzipThreads.clear();
+    m_unzips.clear();
+    m_unzipIndices.clear();
+    m_newlyUnzippedMods.clear();
+}
+
+void Loader::Impl::startLoadingLateMods() {
+    // The early mods have been popped off m_modsToLoad, so everything left 
+    // in it is loaded late
+    m_lateMods.assign(m_modsToLoad.size(), LateMod());
+    m_lateModIndices.clear();
+    m_readyLateMods = {};
+    m_lateModsLeft = m_modsToLoad.size();
+    for (size_t i = 0; i < m_modsToLoad.size(); i += 1) {
+        m_lateModIndices.insert({ m_modsToLoad[i], i });
+    }
+    // This has to match the condition under which buildModGraph adds the 
+    // mod to its dependency's m_dependants
+    for (size_t i = 0; i < m_modsToLoad.size(); i += 1) {
+        for (auto const& dep : m_modsToLoad[i]->m_impl->m_metadata.m_impl->m_dependencies) {
+            if (
+                dep.mod && dep.importance == ModMetadata::Dependency::Importance::Required &&
+                m_lateModIndices.contains(dep.mod)
+            ) {
+                m_lateMods[i].pendingDeps += 1;
+            }
+        }
+    }
+    for (size_t i = 0; i < m_modsToLoad.size(); i += 1) {
+        this->queueLateModIfReady(i);
+    }
+}
+
+void Loader::Impl::queueLateModIfReady(size_t index) {
+    auto& lateMod = m_lateMods[index];
+    if (!lateMod.queued && lateMod.pendingDeps == 0 && this->isModUnzipped(m_modsToLoad[index])) {
+        lateMod.queued = true;
+        m_readyLateMods.push(index);
+    }
+}
+
+void Loader::Impl::queueUnzippedLateMods() {
+    std::vector<Mod*> unzipped;
+    {
+        std::lock_guard lock(m_unzipMutex);
+        std::swap(unzipped, m_newlyUnzippedMods);
+    }
+    for (auto mod : unzipped) {
+        // Early mods were extracted too but have already been loaded
+        auto it = m_lateModIndices.find(mod);
+        if (it != m_lateModIndices.end()) {
+            this->queueLateModIfReady(it->second);
+        }
+    }
+}
+
+bool Loader::Impl::isModUnzipped(Mod* mod) {
+    auto it = m_unzipIndices.find(mod);
+    if (it == m_unzipIndices.end()) {
+        return true;
+    }
+    std::lock_guard lock(m_unzipMutex);
+    return m_unzips[it->second].result.has_value();
+}
+
+Result<> Loader::Impl::waitForModUnzip(Mod* mod, std::chrono::milliseconds& time) {
+    auto it = m_unzipIndices.find(mod);
+    // Not queued for extraction in the background, do it here
+    if (it == m_unzipIndices.end()) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        auto res = mod->m_impl->unzipGeodeFile(mod->getMetadata());
+        time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - begin
+        );
+        return res;
+    }
+    std::unique_lock lock(m_unzipMutex);
+    auto& unzip = m_unzips[it->second];
+    m_unzipCV.wait(lock, [&] { return unzip.result.has_value(); });
+    time = unzip.time;
+    return *unzip.result;
 }
 
 void Loader::Impl::findProblems() {
@@ -671,7 +1094,10 @@ void Loader::Impl::refreshModGraph() {
 
     m_problems.clear();
 
+    m_loadingTimeline.clear();
+
     m_loadingState = LoadingState::Queue;
+    this->beginLoadingPhase("queue");
     log::debug("Queueing mods");
     log::pushNest();
     std::vector<ModMetadata> modQueue;
@@ -679,6 +1105,7 @@ void Loader::Impl::refreshModGraph() {
     log::popNest();
 
     m_loadingState = LoadingState::List;
+    this->beginLoadingPhase("list");
     log::debug("Populating mod list");
     log::pushNest();
     this->populateModList(modQueue);
@@ -686,6 +1113,7 @@ void Loader::Impl::refreshModGraph() {
     log::popNest();
 
     m_loadingState = LoadingState::Graph;
+    this->beginLoadingPhase("graph");
     log::debug("Building mod graph");
     log::pushNest();
     this->buildModGraph();
@@ -696,10 +1124,13 @@ void Loader::Impl::refreshModGraph() {
     this->orderModStack();
     log::popNest();
 
+    this->startUnzippingMods();
+
     m_loadingState = LoadingState::EarlyMods;
+    this->beginLoadingPhase("early");
     log::debug("Loading early mods");
     log::pushNest();
-    while (!m_modsToLoad.empty() && m_modsToLoad.front()->needsEarlyLoad()) {
+    for (; m_earlyModsToLoad > 0 && !m_modsToLoad.empty(); m_earlyModsToLoad -= 1) {
         auto mod = m_modsToLoad.front();
         m_modsToLoad.pop_front();
         this->loadModGraph(mod, true);
@@ -713,6 +1144,8 @@ void Loader::Impl::refreshModGraph() {
     log::popNest();
 
     m_loadingState = LoadingState::Mods;
+    this->beginLoadingPhase("late");
+    this->startLoadingLateMods();
 
     queueInMainThread([&]() {
         this->continueRefreshModGraph();
@@ -720,60 +1153,104 @@ void Loader::Impl::refreshModGraph() {
 }
 
 void Loader::Impl::orderModStack() {
-    std::unordered_set<Mod*> visited;
-    visited.insert(Mod::get());
-    Mod* selectedMod = nullptr;
-    do {
-        selectedMod = nullptr;
-        for (auto const& mod : ModImpl::get()->m_dependants) {
-            if (visited.count(mod) != 0) continue;
-
-            for (auto dep : mod->getMetadata().getDependencies()) {
-                if (dep.mod && dep.importance == ModMetadata::Dependency::Importance::Required && 
-                    visited.count(dep.mod) == 0) {
-                    // the dependency is not visited yet
-                    // so we cant select this mod
-                    goto skip_mod;
-                }
+    // Every mod depends on the loader, so its dependants are all the mods
+    auto const& mods = ModImpl::get()->m_dependants;
+
+    struct Node final {
+        Mod* mod;
+        // Number of required dependencies that haven't been ordered yet
+        size_t pendingDeps = 0;
+        bool early = false;
+    };
+    std::vector<Node> nodes;
+    nodes.reserve(mods.size());
+    std::unordered_map<Mod*, size_t> indices;
+    indices.reserve(mods.size());
+    for (auto mod : mods) {
+        if (indices.try_emplace(mod, nodes.size()).second) {
+            nodes.push_back({ .mod = mod });
+        }
+    }
+
+    // Count incoming edges. This has to match the condition under which 
+    // buildModGraph adds the mod to its dependency's m_dependants
+    std::vector<size_t> earlyStack;
+    for (auto& node : nodes) {
+        for (auto const& dep : node.mod->m_impl->m_metadata.m_impl->m_dependencies) {
+            if (
+                dep.mod && dep.importance == ModMetadata::Dependency::Importance::Required &&
+                indices.contains(dep.mod)
+            ) {
+                node.pendingDeps += 1;
             }
+        }
+        if (node.mod->m_impl->m_metadata.needsEarlyLoad()) {
+            node.early = true;
+            earlyStack.push_back(&node - nodes.data());
+        }
+    }
 
-            if (selectedMod) {
-                if (
-                    !selectedMod->m_impl->needsEarlyLoad() &&
-                    mod->m_impl->needsEarlyLoad()
-                ) {
-                    // this mod is implied to be loaded early
-                    // so we can override a mod that is not
-                    selectedMod = mod;
+    // A mod needs to be loaded early if anything depending on it does, so 
+    // propagate the flag down to dependencies once here instead of walking 
+    // the dependants of every mod on every check
+    while (!earlyStack.empty()) {
+        auto& node = nodes[earlyStack.back()];
+        earlyStack.pop_back();
+        for (auto const& dep : node.mod->m_impl->m_metadata.m_impl->m_dependencies) {
+            if (dep.mod && dep.importance == ModMetadata::Dependency::Importance::Required) {
+                auto it = indices.find(dep.mod);
+                if (it != indices.end() && !nodes[it->second].early) {
+                    nodes[it->second].early = true;
+                    earlyStack.push_back(it->second);
                 }
             }
-            else {
-                selectedMod = mod;
-            }
+        }
+    }
 
-        skip_mod:
-            continue;
+    // Kahn's algorithm. Out of the mods that are ready, early mods go first 
+    // and otherwise mods go in the order they were discovered in
+    auto later = [&](size_t a, size_t b) {
+        if (nodes[a].early != nodes[b].early) {
+            return !nodes[a].early;
+        }
+        return a > b;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(later)> ready(later);
+    for (size_t i = 0; i < nodes.size(); i += 1) {
+        if (nodes[i].pendingDeps == 0) {
+            ready.push(i);
         }
+    }
 
-        if (selectedMod) {
-            m_modsToLoad.push_back(selectedMod);
-            visited.insert(selectedMod);
+    m_modsToLoad.clear();
+    m_earlyModsToLoad = 0;
+    while (!ready.empty()) {
+        auto& node = nodes[ready.top()];
+        ready.pop();
+        m_modsToLoad.push_back(node.mod);
+        if (node.early) {
+            m_earlyModsToLoad += 1;
+        }
+        for (auto dependant : node.mod->m_impl->m_dependants) {
+            auto it = indices.find(dependant);
+            if (it != indices.end() && --nodes[it->second].pendingDeps == 0) {
+                ready.push(it->second);
+            }
         }
-    } while (selectedMod != nullptr);
+    }
 
-    for (auto mod : m_modsToLoad) {
-        log::debug("{}, early: {}", mod->getID(), mod->needsEarlyLoad());
+    if (m_modsToLoad.size() != nodes.size()) {
+        log::warn(
+            "{} mods are part of or depend on a dependency cycle and won't be loaded",
+            nodes.size() - m_modsToLoad.size()
+        );
+    }
+    for (size_t i = 0; i < m_modsToLoad.size(); i += 1) {
+        log::debug("{}, early: {}", m_modsToLoad[i]->getID(), i < m_earlyModsToLoad);
     }
 }
 
 void Loader::Impl::continueRefreshModGraph() {
-    if (m_refreshingModCount != 0) {
-        queueInMainThread([&]() {
-            this->continueRefreshModGraph();
-        });
-        return;
-    }
-
     if  (m_lateRefreshedModCount > 0) {
         auto end = std::chrono::high_resolution_clock::now();
         auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - m_timerBegin).count();
@@ -787,22 +1264,58 @@ void Loader::Impl::continueRefreshModGraph() {
 
     switch (m_loadingState) {
         case LoadingState::Mods:
-            if (!m_modsToLoad.empty()) {
+            if (m_lateModsLeft > 0) {
                 log::debug("Loading mods");
                 log::pushNest();
-                auto mod = m_modsToLoad.front();
-                m_modsToLoad.pop_front();
-                this->loadModGraph(mod, false);
+                // Load as many mods as fit in the frame. A mod that takes 
+                // long to extract only holds up the mods depending on it
+                size_t loaded = 0;
+                while (std::chrono::high_resolution_clock::now() - m_timerBegin < LATE_LOAD_FRAME_BUDGET) {
+                    this->queueUnzippedLateMods();
+                    if (m_readyLateMods.empty()) {
+                        break;
+                    }
+                    auto mod = m_modsToLoad[m_readyLateMods.top()];
+                    m_readyLateMods.pop();
+                    this->loadModGraph(mod, false);
+                    m_lateModsLeft -= 1;
+                    loaded += 1;
+                    for (auto dependant : mod->m_impl->m_dependants) {
+                        auto it = m_lateModIndices.find(dependant);
+                        if (it != m_lateModIndices.end()) {
+                            m_lateMods[it->second].pendingDeps -= 1;
+                            this->queueLateModIfReady(it->second);
+                        }
+                    }
+                }
+                log::debug("Loaded {} mods this frame", loaded);
                 log::popNest();
-                break;
+                if (m_lateModsLeft > 0) {
+                    // If we ran out of mods to load rather than time, 
+                    // everything left is waiting on an extraction, so have 
+                    // the next one to finish continue from here (unless one 
+                    // finished in the meantime)
+                    if (m_readyLateMods.empty()) {
+                        std::lock_guard lock(m_unzipMutex);
+                        m_resumeRefreshAfterUnzip = m_newlyUnzippedMods.empty() &&
+                            m_finishedUnzipCount < m_unzips.size();
+                    }
+                    break;
+                }
             }
+            m_modsToLoad.clear();
+            m_lateMods.clear();
+            m_lateModIndices.clear();
+            this->finishUnzippingMods();
             m_loadingState = LoadingState::Problems;
             [[fallthrough]];
         case LoadingState::Problems:
+            this->beginLoadingPhase("problems");
             log::debug("Finding problems");
             log::pushNest();
             this->findProblems();
             log::popNest();
+            this->endLoadingPhase();
             m_loadingState = LoadingState::Done;
             {
                 auto end = std::chrono::high_resolution_clock::now();
@@ -817,13 +1330,84 @@ void Loader::Impl::continueRefreshModGraph() {
             break;
     }
 
-    if (m_loadingState != LoadingState::Done) {
+    // Don't poll while waiting for an extraction to finish
+    bool waiting;
+    {
+        std::lock_guard lock(m_unzipMutex);
+        waiting = m_resumeRefreshAfterUnzip;
+    }
+    if (m_loadingState != LoadingState::Done && !waiting) {
         queueInMainThread([&]() {
             this->continueRefreshModGraph();
         });
     }
 
     log::popNest();
+
+    if (m_loadingState == LoadingState::Done) {
+        auto listeners = std::move(m_refreshListeners);
+        m_refreshListeners.clear();
+        for (auto& listener : listeners) {
+            listener();
+        }
+    }
+    else {
+        for (auto& listener : m_refreshListeners) {
+            listener();
+        }
+    }
+}
+
+void Loader::Impl::addRefreshListener(utils::MiniFunction<void()>&& listener) {
+    m_refreshListeners.push_back(std::move(listener));
+}
+
+void Loader::Impl::beginLoadingPhase(std::string_view name) {
+    this->endLoadingPhase();
+    m_loadingTimeline.push_back({
+        .name = std::string(name),
+        .begin = std::chrono::steady_clock::now(),
+    });
+    StartupTrace::beginSpan("phase", std::string(name));
+}
+
+void Loader::Impl::endLoadingPhase() {
+    if (!m_loadingTimeline.empty() && !m_loadingTimeline.back().end) {
+        m_loadingTimeline.back().end = std::chrono::steady_clock::now();
+        StartupTrace::endSpan("phase", m_loadingTimeline.back().name);
+    }
+}
+
+matjson::Value Loader::Impl::getLoadingTimeline() const {
+    auto phases = matjson::Array();
+    if (m_loadingTimeline.empty()) {
+        return phases;
+    }
+    auto start = m_loadingTimeline.front().begin;
+    auto toMs = [](auto duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    for (auto& phase : m_loadingTimeline) {
+        auto end = phase.end.value_or(std::chrono::steady_clock::now());
+        phases.push_back(matjson::Object {
+            { "name", phase.name },
+            { "start-ms", toMs(phase.begin - start) },
+            { "duration-ms", toMs(end - phase.begin) },
+        });
+    }
+    return phases;
+}
+
+Result<> Loader::Impl::saveLoadingTimeline(std::filesystem::path const& dir) const {
+    for (auto& phase : m_loadingTimeline) {
+        auto end = phase.end.value_or(std::chrono::steady_clock::now());
+        log::debug(
+            "Loading phase {} took {}ms", phase.name,
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - phase.begin).count()
+        );
+    }
+    GEODE_UNWRAP(file::writeString(dir / "loading-timeline.json", this->getLoadingTimeline().dump()));
+    return Ok();
 }
 
 std::vector<LoadProblem> Loader::Impl::getProblems() const {
@@ -840,45 +1424,137 @@ void Loader::Impl::forceReset() {
     std::filesystem::remove_all(dirs::getTempDir());
 }
 
-bool Loader::Impl::isReadyToHook() const {
-    return m_readyToHook;
+bool Loader::Impl::isReadyToHook(Mod* mod) const {
+    return m_readyToHook && !ranges::contains(m_hookTransactions, mod);
 }
 
 void Loader::Impl::addUninitializedHook(Hook* hook, Mod* mod) {
     m_uninitializedHooks.emplace_back(hook, mod);
 }
 
+void Loader::Impl::removeUninitializedHook(Hook* hook) {
+    ranges::remove(m_uninitializedHooks, [hook](auto const& pair) { return pair.first == hook; });
+}
+
 bool Loader::Impl::loadHooks() {
     m_readyToHook = true;
+    return this->installUninitializedHooks();
+}
+
+void Loader::Impl::beginHookTransaction(Mod* mod) {
+    m_hookTransactions.push_back(mod);
+}
+
+bool Loader::Impl::endHookTransaction(Mod* mod, bool commit) {
+    auto it = std::find(m_hookTransactions.rbegin(), m_hookTransactions.rend(), mod);
+    if (it == m_hookTransactions.rend()) {
+        log::warn("endHookTransaction called without a matching beginHookTransaction");
+        return true;
+    }
+    m_hookTransactions.erase(std::next(it).base());
+    if (ranges::contains(m_hookTransactions, mod)) {
+        return true;
+    }
+    if (!commit) {
+        // A mod's binary is only loaded once, so every hook it has queued 
+        // was claimed during this transaction
+        ranges::remove(m_uninitializedHooks, [mod](auto const& pair) { return pair.second == mod; });
+        return true;
+    }
+    if (!m_readyToHook) {
+        return true;
+    }
+    return this->installUninitializedHooks();
+}
+
+bool Loader::Impl::installUninitializedHooks() {
+    // Hooks of mods that are still in the middle of a transaction stay queued 
+    // until it ends
+    std::vector<std::pair<Hook*, Mod*>> hooks;
+    std::vector<std::pair<Hook*, Mod*>> deferred;
+    for (auto const& pair : m_uninitializedHooks) {
+        (ranges::contains(m_hookTransactions, pair.second) ? deferred : hooks).push_back(pair);
+    }
+    m_uninitializedHooks = std::move(deferred);
+
+    // Group hooks by their target address, so each handler only has to be 
+    // looked up (or created) once no matter how many mods hook it. TulipHook 
+    // has no way to add several hooks to a handler at once, so each hook is 
+    // still added with its own createHook call. The sort is stable so hooks 
+    // on the same address keep the order they were claimed in
+    std::stable_sort(hooks.begin(), hooks.end(), [](auto const& a, auto const& b) {
+        return a.first->m_impl->m_address < b.first->m_impl->m_address;
+    });
+
     bool hadErrors = false;
-    for (auto const& [hook, mod] : m_uninitializedHooks) {
-        auto res = hook->enable();
-        if (!res) {
-            log::logImpl(Severity::Error, mod, "{}", res.unwrapErr());
+    size_t enabledCount = 0;
+    size_t handlerCount = 0;
+    size_t createdHandlerCount = 0;
+    for (size_t i = 0; i < hooks.size();) {
+        auto first = hooks[i].first->m_impl.get();
+        auto end = i + 1;
+        while (end < hooks.size() && hooks[end].first->m_impl->m_address == first->m_address) {
+            end += 1;
+        }
+
+        // Placeholder hooks are refused by enable() with a warning
+        if (first->hasPlaceholderAddress()) {
+            for (; i < end; i += 1) {
+                (void)hooks[i].first->enable();
+            }
+            continue;
+        }
+
+        auto created = !m_handlerHandles.contains(first->m_address);
+        auto handler = this->getOrCreateHandler(first->m_address, first->m_handlerMetadata);
+        if (!handler) {
+            for (; i < end; i += 1) {
+                log::logImpl(Severity::Error, hooks[i].second, "{}", handler.unwrapErr());
+            }
             hadErrors = true;
+            continue;
+        }
+        handlerCount += 1;
+        createdHandlerCount += created ? 1 : 0;
+
+        for (; i < end; i += 1) {
+            auto [hook, mod] = hooks[i];
+            auto res = hook->m_impl->enable(handler.unwrap());
+            if (!res) {
+                log::logImpl(Severity::Error, mod, "{}", res.unwrapErr());
+                hadErrors = true;
+                continue;
+            }
+            enabledCount += 1;
         }
     }
-    m_uninitializedHooks.clear();
+    if (enabledCount) {
+        log::debug(
+            "Enabled {} hooks on {} addresses ({} new handlers)",
+            enabledCount, handlerCount, createdHandlerCount
+        );
+    }
     return !hadErrors;
 }
 
 void Loader::Impl::queueInMainThread(ScheduledFunction&& func) {
-    std::lock_guard<std::mutex> lock(m_mainThreadMutex);
-    m_mainThreadQueue.push_back(std::forward<ScheduledFunction>(func));
+    this->queueInMainThread(std::forward<ScheduledFunction>(func), MainThreadPriority::Normal);
+}
+
+void Loader::Impl::queueInMainThread(ScheduledFunction&& func, MainThreadPriority priority) {
+    m_mainThreadQueue.push(std::forward<ScheduledFunction>(func), priority);
 }
 
 void Loader::Impl::executeMainThreadQueue() {
-    // copy queue to avoid locking mutex if someone is
-    // running addToMainThread inside their function
-    m_mainThreadMutex.lock();
-    auto queue = m_mainThreadQueue;
-    m_mainThreadQueue.clear();
-    m_mainThreadMutex.unlock();
+    m_mainThreadQueue.execute();
+}
 
-    // call queue
-    for (auto const& func : queue) {
-        func();
-    }
+void Loader::Impl::setMainThreadQueueBudget(std::optional<std::chrono::microseconds> budget) {
+    m_mainThreadQueue.setBudget(budget);
+}
+
+MainThreadQueueStats Loader::Impl::getMainThreadQueueStats() const {
+    return m_mainThreadQueue.getStats();
 }
 
 void Loader::Impl::provideNextMod(Mod* mod) {
@@ -903,20 +1579,19 @@ void Loader::Impl::releaseNextMod() {
 // e.g. "--geode:arg=My spaced value"
 void Loader::Impl::initLaunchArguments() {
     auto launchStr = this->getLaunchCommand();
-    auto args = string::split(launchStr, " ");
-    for (const auto& arg : args) {
+    for (auto arg : string::splitView(launchStr, " ")) {
         if (!arg.starts_with(LAUNCH_ARG_PREFIX)) {
             continue;
         }
         auto pair = arg.substr(LAUNCH_ARG_PREFIX.size());
         auto sep = pair.find('=');
-        if (sep == std::string::npos) {
-            m_launchArgs.insert({ pair, "true" });
+        if (sep == std::string_view::npos) {
+            m_launchArgs.insert({ std::string(pair), "true" });
             continue;
         }
         auto key = pair.substr(0, sep);
         auto value = pair.substr(sep + 1);
-        m_launchArgs.insert({ key, value });
+        m_launchArgs.insert({ std::string(key), std::string(value) });
     }
     for (const auto& pair : m_launchArgs) {
         log::debug("Loaded '{}' as '{}'", pair.first, pair.second);
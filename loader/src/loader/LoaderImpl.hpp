@@ -11,8 +11,14 @@
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <Geode/utils/MiniFunction.hpp>
+#include <Geode/utils/cocos.hpp>
 #include "ModImpl.hpp"
+#include "MainThreadQueue.hpp"
 #include <crashlog.hpp>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <thread>
@@ -36,15 +42,20 @@ namespace geode {
         std::vector<LoadProblem> m_problems;
         std::unordered_map<std::string, Mod*> m_mods;
         std::deque<Mod*> m_modsToLoad;
+        // How many mods at the front of m_modsToLoad need to be loaded early
+        size_t m_earlyModsToLoad = 0;
         std::vector<std::filesystem::path> m_texturePaths;
         bool m_isSetup = false;
 
         LoadingState m_loadingState = LoadingState::None;
 
-        std::vector<utils::MiniFunction<void(void)>> m_mainThreadQueue;
-        mutable std::mutex m_mainThreadMutex;
+        MainThreadQueue m_mainThreadQueue;
         std::vector<std::pair<Hook*, Mod*>> m_uninitializedHooks;
         bool m_readyToHook = false;
+        // Mods with an open hook transaction. Hooks claimed by these mods are 
+        // queued into m_uninitializedHooks and installed together when the 
+        // transaction is committed; hooks of every other mod are unaffected
+        std::vector<Mod*> m_hookTransactions;
 
         std::mutex m_nextModMutex;
         std::unique_lock<std::mutex> m_nextModLock = std::unique_lock<std::mutex>(m_nextModMutex, std::defer_lock);
@@ -54,9 +65,108 @@ namespace geode {
 
         Mod* m_currentlyLoadingMod = nullptr;
 
-        int m_refreshingModCount = 0;
         int m_refreshedModCount = 0;
         int m_lateRefreshedModCount = 0;
+        // How long continueRefreshModGraph may spend loading mods on a 
+        // single frame before continuing on the next one
+        static constexpr auto LATE_LOAD_FRAME_BUDGET = std::chrono::milliseconds(12);
+        // Set while continueRefreshModGraph is waiting for a mod to finish 
+        // extracting, so that whichever unzip worker finishes one schedules 
+        // it again instead of it checking on every frame
+        bool m_resumeRefreshAfterUnzip = false;
+        size_t m_finishedUnzipCount = 0;
+        // Mods whose extraction finished since the main thread last checked. 
+        // Guarded by m_unzipMutex
+        std::vector<Mod*> m_newlyUnzippedMods;
+
+        // Late mods are loaded from a queue of the ones that are ready to 
+        // load (extracted, with all of their required dependencies loaded). 
+        // The queue is ordered by position in m_modsToLoad so that mods 
+        // still load in dependency order rather than extraction order
+        struct LateMod final {
+            // Number of required dependencies that haven't been loaded yet
+            size_t pendingDeps = 0;
+            bool queued = false;
+        };
+        std::vector<LateMod> m_lateMods;
+        std::unordered_map<Mod*, size_t> m_lateModIndices;
+        std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> m_readyLateMods;
+        size_t m_lateModsLeft = 0;
+        // Called on the main thread after every step of refreshing the mod 
+        // graph, including the one that finishes it
+        std::vector<utils::MiniFunction<void()>> m_refreshListeners;
+
+        // When each phase of loading started and ended, for finding out 
+        // where startup time goes
+        struct LoadingPhase final {
+            std::string name;
+            std::chrono::steady_clock::time_point begin;
+            std::optional<std::chrono::steady_clock::time_point> end;
+        };
+        std::vector<LoadingPhase> m_loadingTimeline;
+
+        // Mods are extracted on a small pool of worker threads in load 
+        // order, so that extraction overlaps with loading earlier mods
+        struct ModUnzip final {
+            Mod* mod;
+            ModMetadata metadata;
+            std::optional<Result<>> result;
+            std::chrono::milliseconds time {};
+        };
+        static constexpr unsigned MAX_UNZIP_THREADS = 4;
+        std::vector<ModUnzip> m_unzips;
+        std::unordered_map<Mod*, size_t> m_unzipIndices;
+        size_t m_nextUnzip = 0;
+        std::mutex m_unzipMutex;
+        std::condition_variable m_unzipCV;
+        std::vector<std::thread> m_unzipThreads;
+
+        // Mod spritesheet images are decoded on a pool of worker threads, and 
+        // then turned into textures and sprite frames on the main thread a 
+        // few at a time. Sheets are uploaded in the order they were queued so 
+        // that sprite frame overrides between mods stay deterministic
+        struct SpritesheetLoad final {
+            Mod* mod;
+            std::string png;
+            std::string plist;
+            std::string imagePath;
+            Ref<CCImage> image;
+            bool decoded = false;
+        };
+        static constexpr unsigned MAX_RESOURCE_THREADS = 4;
+        std::vector<SpritesheetLoad> m_sheetLoads;
+        size_t m_nextSheetDecode = 0;
+        size_t m_nextSheetUpload = 0;
+        std::mutex m_sheetMutex;
+        std::condition_variable m_sheetCV;
+        std::vector<std::thread> m_sheetThreads;
+        // Set when the game exits, so the decoders stop picking up sheets
+        bool m_stopDecodingSheets = false;
+
+        // Mod data is serialized on the main thread when the game saves and 
+        // written to disk on a background thread. Pending writes are keyed by 
+        // path, so a file saved again before it's been written is only 
+        // written once with its latest contents
+        static constexpr auto SAVE_FLUSH_TIMEOUT = std::chrono::seconds(5);
+        static constexpr auto SHUTDOWN_FLUSH_TIMEOUT = std::chrono::seconds(2);
+        std::map<std::filesystem::path, std::string> m_pendingWrites;
+        // Writes the writer thread has taken but not started yet. It claims 
+        // them one at a time, so flushDataWrites can take over the rest if 
+        // the writer gets stuck
+        std::map<std::filesystem::path, std::string> m_activeWrites;
+        // The file the writer thread is writing right now, which nothing 
+        // else may write at the same time
+        std::optional<std::filesystem::path> m_currentWrite;
+        // Set while flushDataWrites is writing files it took over, so that 
+        // the writer doesn't start on newer versions of them at the same time
+        bool m_callerFlushing = false;
+        // Set when the mod data store has records to append
+        bool m_storeFlushQueued = false;
+        size_t m_queuedWriteGeneration = 0;
+        size_t m_finishedWriteGeneration = 0;
+        bool m_writerStarted = false;
+        std::mutex m_writeMutex;
+        std::condition_variable m_writeCV;
 
         std::unordered_map<std::string, std::string> m_launchArgs;
 
@@ -75,6 +185,7 @@ namespace geode {
         Result<tulip::hook::HandlerHandle> getOrCreateHandler(void* address, tulip::hook::HandlerMetadata const& metadata);
 
         bool loadHooks();
+        bool installUninitializedHooks();
 
         Impl();
         ~Impl();
@@ -82,6 +193,10 @@ namespace geode {
         void createDirectories();
 
         void updateModResources(Mod* mod);
+        void startLoadingResources(bool forceReload);
+        bool continueLoadingResources(std::optional<std::chrono::milliseconds> budget);
+        void stopDecodingResources();
+        std::pair<size_t, size_t> getResourceLoadProgress();
         void addSearchPaths();
         void addNativeBinariesPath(std::filesystem::path const& path);
 
@@ -90,6 +205,14 @@ namespace geode {
 
         void saveData();
         void loadData();
+        void queueDataWrites(std::vector<std::pair<std::filesystem::path, std::string>>&& files);
+        void queueDataStoreFlush();
+        void startDataWriter();
+        // Wait for all queued writes to finish, writing whatever is left on 
+        // the calling thread if they don't within the timeout. Returns false 
+        // if it had to do so
+        bool flushDataWrites(std::chrono::milliseconds timeout);
+        void writeDataLoop();
 
         VersionInfo getVersion();
         VersionInfo minModVersion();
@@ -101,9 +224,22 @@ namespace geode {
         void buildModGraph();
         void orderModStack();
         void loadModGraph(Mod* node, bool early);
+        void startLoadingLateMods();
+        void queueLateModIfReady(size_t index);
+        void queueUnzippedLateMods();
+        void startUnzippingMods();
+        void finishUnzippingMods();
+        bool isModUnzipped(Mod* mod);
+        Result<> waitForModUnzip(Mod* mod, std::chrono::milliseconds& time);
         void findProblems();
         void refreshModGraph();
         void continueRefreshModGraph();
+        void addRefreshListener(utils::MiniFunction<void()>&& listener);
+
+        void beginLoadingPhase(std::string_view name);
+        void endLoadingPhase();
+        matjson::Value getLoadingTimeline() const;
+        Result<> saveLoadingTimeline(std::filesystem::path const& dir) const;
 
         bool isModInstalled(std::string const& id) const;
         Mod* getInstalledMod(std::string const& id) const;
@@ -123,10 +259,23 @@ namespace geode {
         void updateResources(bool forceReload);
 
         void queueInMainThread(ScheduledFunction&& func);
+        void queueInMainThread(ScheduledFunction&& func, MainThreadPriority priority);
         void executeMainThreadQueue();
+        void setMainThreadQueueBudget(std::optional<std::chrono::microseconds> budget);
+        MainThreadQueueStats getMainThreadQueueStats() const;
 
-        bool isReadyToHook() const;
+        bool isReadyToHook(Mod* mod) const;
         void addUninitializedHook(Hook* hook, Mod* mod);
+        void removeUninitializedHook(Hook* hook);
+
+        void beginHookTransaction(Mod* mod);
+        /**
+         * Install every hook `mod` claimed since `beginHookTransaction`, or 
+         * drop them if `commit` is false. Queued hooks of other mods are left 
+         * alone either way
+         * @returns False if some hooks failed to be installed
+         */
+        bool endHookTransaction(Mod* mod, bool commit = true);
 
         Mod* getInternalMod();
         Result<> setupInternalMod();
@@ -0,0 +1,90 @@
+#include "MainThreadQueue.hpp"
+
+#include <algorithm>
+
+using namespace geode;
+
+void MainThreadQueue::push(ScheduledFunction&& func, MainThreadPriority priority) {
+    auto queued = QueuedFunction {
+        .func = std::forward<ScheduledFunction>(func),
+        .queuedAt = std::chrono::steady_clock::now(),
+    };
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue[static_cast<size_t>(priority)].push_back(std::move(queued));
+}
+
+void MainThreadQueue::execute() {
+    // take the queue out to avoid locking mutex if someone is
+    // running queueInMainThread inside their function; anything 
+    // queued while running will run on the next frame
+    std::array<std::vector<QueuedFunction>, LANE_COUNT> incoming;
+    m_mutex.lock();
+    std::swap(incoming, m_queue);
+    // the budget can be changed from any thread
+    auto budget = m_budget;
+    m_mutex.unlock();
+
+    for (size_t lane = 0; lane < LANE_COUNT; lane += 1) {
+        for (auto& queued : incoming[lane]) {
+            m_backlog[lane].push_back(std::move(queued));
+        }
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    auto stats = MainThreadQueueStats();
+    std::chrono::steady_clock::duration totalLatency {};
+
+    // call queue
+    for (size_t lane = 0; lane < LANE_COUNT; lane += 1) {
+        auto& backlog = m_backlog[lane];
+        while (!backlog.empty()) {
+            auto now = std::chrono::steady_clock::now();
+            if (
+                budget && stats.executed > 0 &&
+                lane != static_cast<size_t>(MainThreadPriority::High) &&
+                now - begin >= *budget
+            ) {
+                break;
+            }
+            auto queued = std::move(backlog.front());
+            backlog.pop_front();
+
+            auto latency = now - queued.queuedAt;
+            totalLatency += latency;
+            stats.maxLatency = std::max(
+                stats.maxLatency,
+                std::chrono::duration_cast<std::chrono::microseconds>(latency)
+            );
+            stats.executed += 1;
+
+            queued.func();
+        }
+        stats.deferred += backlog.size();
+    }
+
+    stats.time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin
+    );
+    if (stats.executed) {
+        stats.averageLatency = std::chrono::duration_cast<std::chrono::microseconds>(
+            totalLatency / stats.executed
+        );
+    }
+    stats.pending = stats.deferred;
+    m_mutex.lock();
+    for (auto& lane : m_queue) {
+        stats.pending += lane.size();
+    }
+    m_stats = stats;
+    m_mutex.unlock();
+}
+
+void MainThreadQueue::setBudget(std::optional<std::chrono::microseconds> budget) {
+    std::lock_guard lock(m_mutex);
+    m_budget = budget;
+}
+
+MainThreadQueueStats MainThreadQueue::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
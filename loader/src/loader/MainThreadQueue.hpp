@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Geode/loader/Loader.hpp>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace geode {
+    // The queue behind queueInMainThread, kept separate from the loader so 
+    // it can be tested and benchmarked on its own. Functions can be pushed 
+    // from any thread; execute is called by the main thread once a frame
+    class MainThreadQueue final {
+    private:
+        struct QueuedFunction final {
+            ScheduledFunction func;
+            std::chrono::steady_clock::time_point queuedAt;
+        };
+        static constexpr size_t LANE_COUNT = 3;
+
+        // Functions queued from any thread, one lane per MainThreadPriority. 
+        // These are swapped out as a whole at the start of every frame so the 
+        // lock is only ever held for a push_back or a swap
+        std::array<std::vector<QueuedFunction>, LANE_COUNT> m_queue;
+        mutable std::mutex m_mutex;
+        // Functions taken off the queue that haven't run yet because the 
+        // frame's time budget ran out. Only accessed on the main thread
+        std::array<std::deque<QueuedFunction>, LANE_COUNT> m_backlog;
+        // Guarded by m_mutex
+        std::optional<std::chrono::microseconds> m_budget;
+        MainThreadQueueStats m_stats;
+
+    public:
+        void push(ScheduledFunction&& func, MainThreadPriority priority);
+        // Run the functions queued so far, up to the time budget. Functions 
+        // queued while this runs wait for the next frame
+        void execute();
+
+        void setBudget(std::optional<std::chrono::microseconds> budget);
+        MainThreadQueueStats getStats() const;
+    };
+}
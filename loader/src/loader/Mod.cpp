@@ -48,6 +48,14 @@ matjson::Value& Mod::getSaveContainer() {
     return m_impl->getSaveContainer();
 }
 
+matjson::Value& Mod::getMutableSavedValues() {
+    return m_impl->getMutableSavedValues();
+}
+
+matjson::Value const& Mod::getSavedValues() {
+    return m_impl->getSavedValues();
+}
+
 matjson::Value& Mod::getSavedSettingsData() {
     return m_impl->m_settings->getSaveData();
 }
@@ -168,7 +176,7 @@ SettingValue* Mod::getSetting(std::string_view const key) const {
 }
 
 std::shared_ptr<SettingV3> Mod::getSettingV3(std::string_view const key) const {
-    return m_impl->m_settings->get(std::string(key));
+    return m_impl->m_settings->get(key);
 }
 
 void Mod::registerCustomSetting(std::string_view const key, std::unique_ptr<SettingValue> value) {
@@ -209,6 +217,10 @@ std::vector<Hook*> Mod::getHooks() const {
     return m_impl->getHooks();
 }
 
+Result<std::vector<Patch*>> Mod::patchMany(std::vector<std::pair<void*, ByteVector>> const& patches) {
+    return m_impl->patchMany(patches);
+}
+
 Result<Patch*> Mod::claimPatch(std::shared_ptr<Patch> patch) {
     return m_impl->claimPatch(patch);
 }
@@ -270,7 +282,7 @@ void Mod::setLoggingEnabled(bool enabled) {
 }
 
 bool Mod::hasSavedValue(std::string_view const key) {
-    return this->getSaveContainer().contains(key);
+    return this->getSavedValues().contains(key);
 }
 
 bool Mod::hasProblems() const {
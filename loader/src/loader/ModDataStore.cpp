@@ -0,0 +1,157 @@
+#include "ModDataStore.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/file.hpp>
+#include <fstream>
+
+using namespace geode::prelude;
+
+using Format = ModDataStoreFormat;
+
+ModDataStore& ModDataStore::get() {
+    static ModDataStore inst;
+    return inst;
+}
+
+bool ModDataStore::isEnabled() {
+    static bool enabled = Loader::get()->getLaunchFlag("save-data-store");
+    return enabled;
+}
+
+std::filesystem::path ModDataStore::getPath() const {
+    return dirs::getModsSaveDir() / "mod-data.bin";
+}
+
+bool ModDataStore::exists() {
+    std::lock_guard lock(m_mutex);
+    if (!m_exists) {
+        m_exists = std::filesystem::exists(this->getPath());
+    }
+    return *m_exists;
+}
+
+void ModDataStore::load() {
+    if (m_loaded) {
+        return;
+    }
+    m_loaded = true;
+
+    auto path = this->getPath();
+    m_exists = std::filesystem::exists(path);
+    if (!*m_exists) {
+        return;
+    }
+    auto res = file::readString(path);
+    if (!res) {
+        log::error("Unable to read mod data store: {}", res.unwrapErr());
+        return;
+    }
+    auto& data = res.unwrap();
+    auto size = Format::parse(data, m_entries);
+    if (!size) {
+        log::error("Mod data store is corrupted, ignoring it");
+        m_needsCompaction = true;
+        return;
+    }
+    m_fileSize = *size;
+
+    // Most likely the game crashed while appending to the file
+    if (*size != data.size()) {
+        log::warn("Mod data store ends in an incomplete record, dropping it");
+        m_needsCompaction = true;
+    }
+    log::debug("Loaded mod data store with data for {} mods", m_entries.size());
+}
+
+std::optional<std::string> ModDataStore::read(std::string const& modID, Kind kind) {
+    std::lock_guard lock(m_mutex);
+    this->load();
+    auto it = m_entries.find(modID);
+    if (it == m_entries.end()) {
+        return std::nullopt;
+    }
+    return kind == Kind::Settings ? it->second.settings : it->second.savedValues;
+}
+
+void ModDataStore::write(std::string const& modID, Kind kind, std::string data) {
+    std::lock_guard lock(m_mutex);
+    this->load();
+    Format::appendRecord(m_pending, modID, kind, data);
+    auto& entry = m_entries[modID];
+    (kind == Kind::Settings ? entry.settings : entry.savedValues) = std::move(data);
+}
+
+void ModDataStore::erase(std::string const& modID) {
+    std::lock_guard lock(m_mutex);
+    this->load();
+    if (m_entries.erase(modID)) {
+        Format::appendRecord(m_pending, modID, Kind::Erase, "");
+    }
+}
+
+bool ModDataStore::hasPendingChanges() {
+    std::lock_guard lock(m_mutex);
+    return m_pending.size() || m_needsCompaction;
+}
+
+Result<> ModDataStore::flush() {
+    std::unique_lock fileLock(m_fileMutex, std::chrono::seconds(1));
+    if (!fileLock) {
+        return Err("Timed out waiting for the file to be available");
+    }
+
+    std::string data;
+    bool compact;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_pending.empty() && !m_needsCompaction) {
+            return Ok();
+        }
+        compact = m_needsCompaction || Format::shouldCompact(
+            m_fileSize, m_pending.size(), Format::compactedSize(m_entries)
+        );
+        if (compact) {
+            // Nothing left in the store means everything has been migrated
+            // back to JSON files, so the file can just be removed
+            data = Format::compact(m_entries);
+            m_fileSize = data.size();
+        }
+        else {
+            data = std::move(m_pending);
+            m_fileSize += data.size();
+        }
+        m_pending.clear();
+        m_needsCompaction = false;
+        m_exists = m_fileSize > 0;
+    }
+
+    auto res = [&]() -> Result<> {
+        if (compact && data.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(this->getPath(), ec);
+            if (ec) {
+                return Err("Unable to remove file: {}", ec.message());
+            }
+        }
+        else if (compact) {
+            GEODE_UNWRAP(file::writeStringSafe(this->getPath(), data));
+        }
+        else {
+            std::ofstream file(this->getPath(), std::ios::out | std::ios::binary | std::ios::app);
+            file.write(data.data(), data.size());
+            file.flush();
+            if (!file) {
+                return Err("Unable to append to file");
+            }
+        }
+        return Ok();
+    }();
+    if (!res) {
+        // Everything is still in memory, so just rewrite the whole file next time
+        std::lock_guard lock(m_mutex);
+        m_needsCompaction = true;
+    }
+    return res;
+}
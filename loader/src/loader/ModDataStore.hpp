@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ModDataStoreFormat.hpp"
+
+#include <Geode/utils/Result.hpp>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace geode {
+    // A single file holding every mod's settings and saved values, used
+    // instead of a settings.json and saved.json per mod when the game is
+    // launched with `--geode:save-data-store`. This way startup only has to
+    // read one file rather than two for every installed mod.
+    // The file is an append-only log of records; the newest record for a mod
+    // wins, and the log is compacted once it has grown to twice the size of
+    // the data it actually holds
+    class ModDataStore final {
+    public:
+        using Kind = ModDataStoreFormat::Kind;
+
+    private:
+        std::mutex m_mutex;
+        // Held while the file is being written, so the writer thread and a
+        // flush at exit don't append to it at the same time. Timed since the
+        // writer thread may have been killed while holding it at exit
+        std::timed_mutex m_fileMutex;
+        bool m_loaded = false;
+        std::optional<bool> m_exists;
+        ModDataStoreFormat::Entries m_entries;
+        // Records that haven't been appended to the file yet
+        std::string m_pending;
+        size_t m_fileSize = 0;
+        bool m_needsCompaction = false;
+
+        ModDataStore() = default;
+
+        void load();
+        void append(std::string const& modID, Kind kind, std::string_view data);
+
+    public:
+        static ModDataStore& get();
+        static bool isEnabled();
+
+        std::filesystem::path getPath() const;
+        // Whether the store file exists, i.e. the store is either enabled or
+        // still has data from an earlier session where it was
+        bool exists();
+
+        // Get a mod's data. The store file is read on first access
+        std::optional<std::string> read(std::string const& modID, Kind kind);
+        // Set a mod's data. It's written to the file on the next flush
+        void write(std::string const& modID, Kind kind, std::string data);
+        // Remove a mod's data, after it's been migrated back to JSON files
+        void erase(std::string const& modID);
+
+        bool hasPendingChanges();
+        // Append pending records to the file, or rewrite the whole file if
+        // it's due for compaction. Safe to call from any thread
+        Result<> flush();
+    };
+}
@@ -0,0 +1,81 @@
+#include "ModDataStoreFormat.hpp"
+
+#include <cstring>
+
+using namespace geode;
+
+void ModDataStoreFormat::appendRecord(std::string& out, std::string_view id, Kind kind, std::string_view data) {
+    char header[RECORD_HEADER_SIZE];
+    auto idSize = static_cast<uint32_t>(id.size());
+    auto dataSize = static_cast<uint32_t>(data.size());
+    header[0] = static_cast<char>(kind);
+    std::memcpy(header + 1, &idSize, sizeof(idSize));
+    std::memcpy(header + 5, &dataSize, sizeof(dataSize));
+    out.append(header, RECORD_HEADER_SIZE);
+    out.append(id);
+    out.append(data);
+}
+
+std::optional<size_t> ModDataStoreFormat::parse(std::string_view data, Entries& entries) {
+    if (!data.starts_with(STORE_HEADER)) {
+        return std::nullopt;
+    }
+    size_t offset = STORE_HEADER.size();
+    while (offset + RECORD_HEADER_SIZE <= data.size()) {
+        uint32_t idSize, dataSize;
+        auto kind = static_cast<Kind>(data[offset]);
+        std::memcpy(&idSize, data.data() + offset + 1, sizeof(idSize));
+        std::memcpy(&dataSize, data.data() + offset + 5, sizeof(dataSize));
+        auto size = RECORD_HEADER_SIZE + static_cast<size_t>(idSize) + dataSize;
+        if (offset + size > data.size()) {
+            break;
+        }
+        auto id = std::string(data.substr(offset + RECORD_HEADER_SIZE, idSize));
+        auto value = std::string(data.substr(offset + RECORD_HEADER_SIZE + idSize, dataSize));
+        switch (kind) {
+            case Kind::Settings: entries[id].settings = std::move(value); break;
+            case Kind::SavedValues: entries[id].savedValues = std::move(value); break;
+            case Kind::Erase: entries.erase(id); break;
+        }
+        offset += size;
+    }
+    return offset;
+}
+
+size_t ModDataStoreFormat::compactedSize(Entries const& entries) {
+    if (entries.empty()) {
+        return 0;
+    }
+    size_t size = STORE_HEADER.size();
+    for (auto& [id, entry] : entries) {
+        if (entry.settings) {
+            size += RECORD_HEADER_SIZE + id.size() + entry.settings->size();
+        }
+        if (entry.savedValues) {
+            size += RECORD_HEADER_SIZE + id.size() + entry.savedValues->size();
+        }
+    }
+    return size;
+}
+
+bool ModDataStoreFormat::shouldCompact(size_t fileSize, size_t pendingSize, size_t compactedSize) {
+    return fileSize == 0 || fileSize + pendingSize > compactedSize * 2;
+}
+
+std::string ModDataStoreFormat::compact(Entries const& entries) {
+    std::string data;
+    if (entries.empty()) {
+        return data;
+    }
+    data.reserve(compactedSize(entries));
+    data.append(STORE_HEADER);
+    for (auto& [id, entry] : entries) {
+        if (entry.settings) {
+            appendRecord(data, id, Kind::Settings, *entry.settings);
+        }
+        if (entry.savedValues) {
+            appendRecord(data, id, Kind::SavedValues, *entry.savedValues);
+        }
+    }
+    return data;
+}
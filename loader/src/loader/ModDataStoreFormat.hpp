@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace geode {
+    // The file format of ModDataStore, kept separate from the store itself 
+    // so it has no dependencies on the rest of the loader.
+    // A file is STORE_HEADER followed by records, each of which is a kind 
+    // (1 byte), an ID size and a data size (4 bytes each), the ID and the data
+    class ModDataStoreFormat final {
+    public:
+        enum class Kind : uint8_t {
+            Settings = 0,
+            SavedValues = 1,
+            // Removes all of a mod's data from the store
+            Erase = 2,
+        };
+
+        struct Entry final {
+            std::optional<std::string> settings;
+            std::optional<std::string> savedValues;
+        };
+        using Entries = std::unordered_map<std::string, Entry>;
+
+        // Magic and format version
+        static constexpr std::string_view STORE_HEADER = std::string_view("GMDS\x01\0\0\0", 8);
+        static constexpr size_t RECORD_HEADER_SIZE = 9;
+
+        static void appendRecord(std::string& out, std::string_view id, Kind kind, std::string_view data);
+        // Read the records of a file into `entries`, with later records 
+        // replacing earlier ones. Returns how much of the file was made up 
+        // of complete records, or nullopt if it isn't a store file at all
+        static std::optional<size_t> parse(std::string_view data, Entries& entries);
+
+        // The size of the file if it were rewritten with only the latest data
+        static size_t compactedSize(Entries const& entries);
+        // Whether the file has grown to over twice the size of its data. A 
+        // missing file always gets written in full
+        static bool shouldCompact(size_t fileSize, size_t pendingSize, size_t compactedSize);
+        // The contents of the compacted file, which are empty if there's no 
+        // data left at all
+        static std::string compact(Entries const& entries);
+    };
+}
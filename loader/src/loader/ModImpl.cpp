@@ -1,5 +1,7 @@
 #include "ModImpl.hpp"
 #include "LoaderImpl.hpp"
+#include "ModDataStore.hpp"
+#include "StartupTrace.hpp"
 #include "ModMetadataImpl.hpp"
 #include "HookImpl.hpp"
 #include "PatchImpl.hpp"
@@ -134,7 +136,34 @@ VersionInfo Mod::Impl::getVersion() const {
     return m_metadata.getVersion();
 }
 
+matjson::Value const& Mod::Impl::getSavedValues() {
+    // Saved values are only parsed once something actually needs them
+    if (m_unparsedSavedValues) {
+        std::string error;
+        auto res = matjson::parse(*m_unparsedSavedValues, error);
+        if (error.size() > 0) {
+            log::error("Unable to parse saved values for {}: {}", m_metadata.getID(), error);
+        }
+        else if (!res.value().is_object()) {
+            log::warn("saved.json was somehow not an object, forcing it to one");
+        }
+        else {
+            m_saved = res.value();
+        }
+        m_unparsedSavedValues = std::nullopt;
+    }
+    return m_saved;
+}
+
 matjson::Value& Mod::Impl::getSaveContainer() {
+    this->getSavedValues();
+    m_saveContainerHandedOut = true;
+    return m_saved;
+}
+
+matjson::Value& Mod::Impl::getMutableSavedValues() {
+    this->getSavedValues();
+    m_savedValuesChanged = true;
     return m_saved;
 }
 
@@ -173,58 +202,113 @@ std::vector<Patch*> Mod::Impl::getPatches() const {
 // Settings and saved values
 
 Result<> Mod::Impl::loadData() {
-    // Settings
-    // Check if settings exist
-    auto settingPath = m_saveDirPath / "settings.json";
-    if (std::filesystem::exists(settingPath)) {
-        GEODE_UNWRAP_INTO(auto json, utils::file::readJson(settingPath));
-        auto load = m_settings->load(json);
-        if (!load) {
-            log::warn("Unable to load settings: {}", load.unwrapErr());
+    std::optional<std::string> settings;
+    std::optional<std::string> saved;
+
+    // Prefer the data store if it's enabled or still has data from when it 
+    // was, since it's always newer than the JSON files
+    auto& store = ModDataStore::get();
+    bool fromStore = false;
+    if (ModDataStore::isEnabled() || store.exists()) {
+        settings = store.read(m_metadata.getID(), ModDataStore::Kind::Settings);
+        saved = store.read(m_metadata.getID(), ModDataStore::Kind::SavedValues);
+        fromStore = settings || saved;
+    }
+    if (!fromStore) {
+        auto settingPath = m_saveDirPath / "settings.json";
+        if (std::filesystem::exists(settingPath)) {
+            GEODE_UNWRAP_INTO(settings, utils::file::readString(settingPath));
+        }
+        auto savedPath = m_saveDirPath / "saved.json";
+        if (std::filesystem::exists(savedPath)) {
+            GEODE_UNWRAP_INTO(saved, utils::file::readString(savedPath));
         }
     }
+    // If the data didn't come from where it's going to be saved, it needs to 
+    // be written there on the next save regardless of whether it changes
+    m_migrateData = fromStore != ModDataStore::isEnabled() && (settings || saved);
 
-    // Saved values
-    auto savedPath = m_saveDirPath / "saved.json";
-    if (std::filesystem::exists(savedPath)) {
-        GEODE_UNWRAP_INTO(auto data, utils::file::readString(savedPath));
+    // Settings
+    if (settings) {
         std::string error;
-        auto res = matjson::parse(data, error);
+        auto json = matjson::parse(*settings, error);
         if (error.size() > 0) {
-            return Err("Unable to parse saved values: " + error);
+            return Err("Unable to parse settings: " + error);
         }
-        m_saved = res.value();
-        if (!m_saved.is_object()) {
-            log::warn("saved.json was somehow not an object, forcing it to one");
-            m_saved = matjson::Object();
+        auto load = m_settings->load(json.value());
+        if (!load) {
+            log::warn("Unable to load settings: {}", load.unwrapErr());
         }
+        m_lastSettingsHash = std::hash<std::string>()(*settings);
+    }
+
+    // Saved values are parsed on first access
+    if (saved) {
+        m_lastSavedValuesHash = std::hash<std::string>()(*saved);
+        m_unparsedSavedValues = std::move(saved);
     }
 
     return Ok();
 }
 
-Result<> Mod::Impl::saveData() {
+std::vector<std::pair<std::filesystem::path, std::string>> Mod::Impl::serializeData() {
+    std::vector<std::pair<std::filesystem::path, std::string>> files;
     if (this->getRequestedAction() == ModRequestedAction::UninstallWithSaveData) {
         // Don't save data if the mod is being uninstalled with save data
-        return Ok();
+        return files;
     }
 
+    bool useStore = ModDataStore::isEnabled();
+    auto save = [&](ModDataStore::Kind kind, char const* filename, std::string&& data, size_t& lastHash) {
+        auto hash = std::hash<std::string>()(data);
+        if (hash == lastHash && !m_migrateData) {
+            return;
+        }
+        lastHash = hash;
+        if (useStore) {
+            ModDataStore::get().write(m_metadata.getID(), kind, std::move(data));
+        }
+        else {
+            files.emplace_back(m_saveDirPath / filename, std::move(data));
+        }
+    };
+
     // ModSettingsManager keeps track of the whole savedata
-    matjson::Value json;
-    m_settings->save(json);
+    if (m_settings->hasUnsavedChanges() || m_migrateData) {
+        matjson::Value json;
+        m_settings->save(json);
+        save(ModDataStore::Kind::Settings, "settings.json", json.dump(), m_lastSettingsHash);
+    }
 
-    // saveData is expected to be synchronous, and always called from GD thread
+    // Always called from GD thread. Mods commonly update their saved values 
+    // in response to this, so it has to be posted before serializing them
     ModStateEvent(m_self, ModEventType::DataSaved).post();
 
-    auto res = utils::file::writeString(m_saveDirPath / "settings.json", json.dump());
-    if (!res) {
-        log::error("Unable to save settings: {}", res.unwrapErr());
+    if (m_savedValuesChanged || m_saveContainerHandedOut || m_migrateData) {
+        m_savedValuesChanged = false;
+        m_saveContainerHandedOut = false;
+        // No need to parse saved values just to dump them again
+        auto data = m_unparsedSavedValues ? *m_unparsedSavedValues : m_saved.dump();
+        save(ModDataStore::Kind::SavedValues, "saved.json", std::move(data), m_lastSavedValuesHash);
     }
-    auto res2 = utils::file::writeString(m_saveDirPath / "saved.json", m_saved.dump());
-    if (!res2) {
-        log::error("Unable to save values: {}", res2.unwrapErr());
+
+    // Data that's been moved back to JSON files can be dropped from the store
+    if (m_migrateData && !useStore) {
+        ModDataStore::get().erase(m_metadata.getID());
     }
+    m_migrateData = false;
+
+    return files;
+}
 
+Result<> Mod::Impl::saveData() {
+    // saveData is expected to be synchronous, so wait for the files to be 
+    // written before returning
+    LoaderImpl::get()->queueDataWrites(this->serializeData());
+    if (ModDataStore::get().hasPendingChanges()) {
+        LoaderImpl::get()->queueDataStoreFlush();
+    }
+    LoaderImpl::get()->flushDataWrites(LoaderImpl::SAVE_FLUSH_TIMEOUT);
     return Ok();
 }
 
@@ -290,6 +374,8 @@ Result<> Mod::Impl::loadBinary() {
     if (m_enabled)
         return Ok();
 
+    StartupTrace::Scope trace("mod", "Load binary of {}", m_metadata.getID());
+
     if (!std::filesystem::exists(this->getBinaryPath())) {
         return Err(
             fmt::format(
@@ -304,7 +390,13 @@ Result<> Mod::Impl::loadBinary() {
 
     m_enabled = true;
     m_isCurrentlyLoading = true;
+    // Hooks are claimed one by one by the mod's static initializers, so 
+    // collect them and install them all at once after the binary is loaded
+    LoaderImpl::get()->beginHookTransaction(m_self);
     auto res = this->loadPlatformBinary();
+    if (!LoaderImpl::get()->endHookTransaction(m_self, res.isOk())) {
+        log::error("Failed to enable some hooks for mod {}", m_metadata.getID());
+    }
     if (!res) {
         m_isCurrentlyLoading = false;
         m_enabled = false;
@@ -317,7 +409,11 @@ Result<> Mod::Impl::loadBinary() {
     LoaderImpl::get()->releaseNextMod();
 
 
-    ModStateEvent(m_self, ModEventType::Loaded).post();
+    {
+        // This is where $on_mod(Loaded) runs
+        StartupTrace::Scope eventTrace("mod", "Loaded event of {}", m_metadata.getID());
+        ModStateEvent(m_self, ModEventType::Loaded).post();
+    }
     ModStateEvent(m_self, ModEventType::Enabled).post();
     ModStateEvent(m_self, ModEventType::DataLoaded).post();
 
@@ -385,7 +481,7 @@ Result<> Mod::Impl::uninstall(bool deleteSaveData) {
         ModRequestedAction::Uninstall;
 
     // Make loader forget the mod should be disabled
-    Mod::get()->getSaveContainer().try_erase("should-load-" + m_metadata.getID());
+    Mod::get()->getMutableSavedValues().try_erase("should-load-" + m_metadata.getID());
 
     std::error_code ec;
     std::filesystem::remove(m_metadata.getPath(), ec);
@@ -396,6 +492,12 @@ Result<> Mod::Impl::uninstall(bool deleteSaveData) {
     }
 
     if (deleteSaveData) {
+        // The mod's data may also be in the store, even if it's no longer 
+        // enabled
+        ModDataStore::get().erase(m_metadata.getID());
+        if (ModDataStore::get().hasPendingChanges()) {
+            LoaderImpl::get()->queueDataStoreFlush();
+        }
         std::filesystem::remove_all(this->getSaveDir(), ec);
         if (ec) {
             return Err(
@@ -460,7 +562,7 @@ Result<Hook*> Mod::Impl::claimHook(std::shared_ptr<Hook> hook) {
     if (!this->isEnabled() || !hook->getAutoEnable())
         return Ok(ptr);
 
-    if (!LoaderImpl::get()->isReadyToHook() && hook->getAutoEnable()) {
+    if (!LoaderImpl::get()->isReadyToHook(m_self) && hook->getAutoEnable()) {
         LoaderImpl::get()->addUninitializedHook(ptr, m_self);
         return Ok(ptr);
     }
@@ -492,6 +594,7 @@ Result<> Mod::Impl::disownHook(Hook* hook) {
                    "didn't have the hook in m_hooks.");
 
     m_hooks.erase(foundIt);
+    LoaderImpl::get()->removeUninitializedHook(hook);
 
     if (!this->isEnabled() || !hook->getAutoEnable())
         return Ok();
@@ -506,6 +609,44 @@ Result<> Mod::Impl::disownHook(Hook* hook) {
 
 // Patches
 
+Result<std::vector<Patch*>> Mod::Impl::patchMany(std::vector<std::pair<void*, ByteVector>> const& patches) {
+    // Validate the whole batch before writing anything
+    std::vector<std::pair<uintptr_t, size_t>> spans;
+    spans.reserve(patches.size());
+    for (auto& [address, data] : patches) {
+        if (data.empty()) {
+            return Err("Cannot apply empty patch at {}", address);
+        }
+        spans.push_back({ reinterpret_cast<uintptr_t>(address), data.size() });
+        GEODE_UNWRAP(Patch::Impl::checkOverlaps(spans.back().first, data.size()));
+    }
+    std::sort(spans.begin(), spans.end());
+    for (size_t i = 1; i < spans.size(); i += 1) {
+        auto [prevAddress, prevSize] = spans[i - 1];
+        if (prevAddress + prevSize > spans[i].first) {
+            return Err(
+                "Cannot apply patches: patch at {} overlaps patch at {}",
+                reinterpret_cast<void*>(spans[i].first), reinterpret_cast<void*>(prevAddress)
+            );
+        }
+    }
+
+    std::vector<Patch*> ret;
+    ret.reserve(patches.size());
+    for (auto& [address, data] : patches) {
+        auto res = this->claimPatch(Patch::create(address, data));
+        if (!res) {
+            // Revert the patches that were already applied
+            for (auto it = ret.rbegin(); it != ret.rend(); ++it) {
+                (void)this->disownPatch(*it);
+            }
+            return Err("Cannot apply patch at {}: {}", address, res.unwrapErr());
+        }
+        ret.push_back(res.unwrap());
+    }
+    return Ok(std::move(ret));
+}
+
 Result<Patch*> Mod::Impl::claimPatch(std::shared_ptr<Patch> patch) {
     auto res1 = patch->m_impl->setOwner(m_self);
     if (!res1) {
@@ -589,6 +730,8 @@ Result<> Mod::Impl::createTempDir() {
 }
 
 Result<> Mod::Impl::unzipGeodeFile(ModMetadata metadata) {
+    StartupTrace::Scope trace("mod", "Unzip {}", metadata.getID());
+
     // Unzip .geode file into temp dir
     auto tempDir = dirs::getModRuntimeDir() / metadata.getID();
 
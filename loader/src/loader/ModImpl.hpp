@@ -48,6 +48,34 @@ namespace geode {
          * Saved values
          */
         matjson::Value m_saved = matjson::Object();
+        /**
+         * Whether the saved values have changed since they were last saved. 
+         * Set by setSavedValue and getMutableSavedValues
+         */
+        bool m_savedValuesChanged = false;
+        /**
+         * Whether the saved values have been handed out through 
+         * getSaveContainer since they were last saved. There's no telling 
+         * whether those callers change them, so they're serialized on the 
+         * next save and only written if they differ from the last write
+         */
+        bool m_saveContainerHandedOut = false;
+        /**
+         * Saved values as read from disk, until something first accesses them
+         */
+        std::optional<std::string> m_unparsedSavedValues;
+        /**
+         * Whether the data was loaded from somewhere other than where it's 
+         * going to be saved (the data store or the JSON files), and so needs 
+         * to be saved even if it hasn't changed
+         */
+        bool m_migrateData = false;
+        /**
+         * Hashes of the last written settings.json and saved.json, so files 
+         * whose contents haven't actually changed aren't rewritten
+         */
+        size_t m_lastSettingsHash = 0;
+        size_t m_lastSavedValuesHash = 0;
         /**
          * Setting values. This is behind unique_ptr for interior mutability
          */
@@ -97,6 +125,8 @@ namespace geode {
         std::filesystem::path getBinaryPath() const;
 
         matjson::Value& getSaveContainer();
+        matjson::Value& getMutableSavedValues();
+        matjson::Value const& getSavedValues();
 
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
         void setMetadata(ModMetadata const& metadata);
@@ -105,6 +135,11 @@ namespace geode {
 
         Result<> saveData();
         Result<> loadData();
+        /**
+         * Serialize the settings and saved values that have changed since the 
+         * last save, returning the files that need to be written
+         */
+        std::vector<std::pair<std::filesystem::path, std::string>> serializeData();
 
         std::filesystem::path getSaveDir() const;
         std::filesystem::path getConfigDir(bool create = true) const;
@@ -124,6 +159,7 @@ namespace geode {
         Result<> disownHook(Hook* hook);
         [[nodiscard]] std::vector<Hook*> getHooks() const;
 
+        Result<std::vector<Patch*>> patchMany(std::vector<std::pair<void*, ByteVector>> const& patches);
         Result<Patch*> claimPatch(std::shared_ptr<Patch> patch);
         Result<> disownPatch(Patch* patch);
         [[nodiscard]] std::vector<Patch*> getPatches() const;
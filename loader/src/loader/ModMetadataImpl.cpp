@@ -1,3 +1,4 @@
+#include <Geode/loader/Dirs.hpp>
 #include <Geode/loader/Loader.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <Geode/utils/VersionInfo.hpp>
@@ -8,6 +9,9 @@
 #include <matjson.hpp>
 #include <utility>
 #include <clocale>
+#include <array>
+#include <list>
+#include <mutex>
 
 #include "ModMetadataImpl.hpp"
 #include "LoaderImpl.hpp"
@@ -65,6 +69,96 @@ static std::string sanitizeDetailsData(std::string const& str) {
     return utils::string::replace(str, "\r", "");
 }
 
+// In the same order as getSpecialFiles
+static constexpr std::array<char const*, 3> SPECIAL_FILE_NAMES = {
+    "about.md", "changelog.md", "support.md",
+};
+
+namespace {
+    // Keeps the most recently read special files around, since the same mod's 
+    // page is often opened multiple times in a row
+    class SpecialFilesCache final {
+    private:
+        static constexpr size_t MAX_ENTRIES = 16;
+        using Entry = std::pair<std::string, std::optional<std::string>>;
+
+        std::mutex m_mutex;
+        std::list<Entry> m_entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+
+        static std::optional<std::string> read(
+            std::filesystem::path const& source, bool inZip, std::string const& modID, 
+            VersionInfo const& version, std::string const& name
+        ) {
+            if (!inZip) {
+                auto res = file::readString(source / name);
+                if (!res) {
+                    log::warn("Unable to read \"{}\" for {}: {}", name, modID, res.unwrapErr());
+                    return std::nullopt;
+                }
+                return sanitizeDetailsData(res.unwrap());
+            }
+            // Reading from the extracted files is cheaper than opening the 
+            // zip, but they're only guaranteed to be from the same package if 
+            // the mod is loaded from it. Updating a mod replaces its package 
+            // in place while the old version stays loaded, so the path alone 
+            // isn't enough
+            auto mod = Loader::get()->getLoadedMod(modID);
+            auto extracted = dirs::getModRuntimeDir() / modID / name;
+            if (
+                mod && mod->getPackagePath() == source && mod->getVersion() == version &&
+                std::filesystem::exists(extracted)
+            ) {
+                return read(extracted.parent_path(), false, modID, version, name);
+            }
+            auto res = [&]() -> Result<ByteVector> {
+                GEODE_UNWRAP_INTO(auto unzip, file::Unzip::create(source));
+                return unzip.extract(name);
+            }();
+            if (!res) {
+                log::warn("Unable to extract \"{}\" for {}: {}", name, modID, res.unwrapErr());
+                return std::nullopt;
+            }
+            auto data = res.unwrap();
+            return sanitizeDetailsData(std::string(data.begin(), data.end()));
+        }
+
+    public:
+        static SpecialFilesCache& get() {
+            static SpecialFilesCache inst;
+            return inst;
+        }
+
+        std::optional<std::string> getFile(
+            std::filesystem::path const& source, bool inZip, std::string const& modID, 
+            VersionInfo const& version, std::string const& name
+        ) {
+            // The version is part of the key since updating a mod replaces 
+            // its package in place
+            auto key = fmt::format("{}/{}/{}/{}", modID, version, source, name);
+            std::unique_lock lock(m_mutex);
+            if (auto it = m_index.find(key); it != m_index.end()) {
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                return it->second->second;
+            }
+            lock.unlock();
+
+            auto value = read(source, inZip, modID, version, name);
+
+            lock.lock();
+            if (!m_index.contains(key)) {
+                m_entries.emplace_front(key, value);
+                m_index.emplace(key, m_entries.begin());
+                if (m_entries.size() > MAX_ENTRIES) {
+                    m_index.erase(m_entries.back().first);
+                    m_entries.pop_back();
+                }
+            }
+            return value;
+        }
+    };
+}
+
 bool ModMetadata::Impl::validateOldID(std::string const& id) {
     // Old IDs may not be empty
     if (id.empty()) return false;
@@ -406,36 +500,61 @@ Result<ModMetadata> ModMetadata::Impl::createFromGeodeZip(file::Unzip& unzip) {
 }
 
 Result<> ModMetadata::Impl::addSpecialFiles(file::Unzip& unzip) {
-    // unzip known MD files
-    for (auto& [file, target] : this->getSpecialFiles()) {
-        if (unzip.hasEntry(file)) {
-            GEODE_UNWRAP_INTO(auto data, unzip.extract(file).expect("Unable to extract \"{}\"", file));
-            *target = sanitizeDetailsData(std::string(data.begin(), data.end()));
+    // Zips opened from memory can't be read again later, so those have to be 
+    // extracted right away
+    if (unzip.getPath().empty()) {
+        for (auto& [file, target] : this->getSpecialFiles()) {
+            if (unzip.hasEntry(file)) {
+                GEODE_UNWRAP_INTO(auto data, unzip.extract(file).expect("Unable to extract \"{}\"", file));
+                *target = sanitizeDetailsData(std::string(data.begin(), data.end()));
+            }
+        }
+        return Ok();
+    }
+    m_specialFilesSource = unzip.getPath();
+    m_specialFilesInZip = true;
+    m_lazySpecialFiles = 0;
+    for (size_t i = 0; i < SPECIAL_FILE_NAMES.size(); i += 1) {
+        if (unzip.hasEntry(SPECIAL_FILE_NAMES[i])) {
+            m_lazySpecialFiles |= 1 << i;
         }
     }
     return Ok();
 }
 
 Result<> ModMetadata::Impl::addSpecialFiles(std::filesystem::path const& dir) {
-    // unzip known MD files
-    for (auto& [file, target] : this->getSpecialFiles()) {
-        if (std::filesystem::exists(dir / file)) {
-            auto data = file::readString(dir / file);
-            if (!data) {
-                return Err("Unable to read \"" + file + "\": " + data.unwrapErr());
-            }
-            *target = sanitizeDetailsData(data.unwrap());
+    m_specialFilesSource = dir;
+    m_specialFilesInZip = false;
+    m_lazySpecialFiles = 0;
+    for (size_t i = 0; i < SPECIAL_FILE_NAMES.size(); i += 1) {
+        if (std::filesystem::exists(dir / SPECIAL_FILE_NAMES[i])) {
+            m_lazySpecialFiles |= 1 << i;
         }
     }
     return Ok();
 }
 
 std::vector<std::pair<std::string, std::optional<std::string>*>> ModMetadata::Impl::getSpecialFiles() {
-    return {
-        {"about.md", &this->m_details},
-        {"changelog.md", &this->m_changelog},
-        {"support.md", &this->m_supportInfo},
+    std::vector<std::pair<std::string, std::optional<std::string>*>> files = {
+        {SPECIAL_FILE_NAMES[0], &this->m_details},
+        {SPECIAL_FILE_NAMES[1], &this->m_changelog},
+        {SPECIAL_FILE_NAMES[2], &this->m_supportInfo},
     };
+    // Whoever asks for these expects them to be filled in
+    for (size_t i = 0; i < files.size(); i += 1) {
+        *files[i].second = this->getSpecialFile(i, *files[i].second);
+    }
+    m_lazySpecialFiles = 0;
+    return files;
+}
+
+std::optional<std::string> ModMetadata::Impl::getSpecialFile(size_t index, std::optional<std::string> const& value) const {
+    if (value || !(m_lazySpecialFiles & (1 << index))) {
+        return value;
+    }
+    return SpecialFilesCache::get().getFile(
+        m_specialFilesSource, m_specialFilesInZip, m_id, m_version, SPECIAL_FILE_NAMES[index]
+    );
 }
 
 ModJson ModMetadata::Impl::toJSON() const {
@@ -502,13 +621,13 @@ std::optional<std::string> ModMetadata::getDescription() const {
     return m_impl->m_description;
 }
 std::optional<std::string> ModMetadata::getDetails() const {
-    return m_impl->m_details;
+    return m_impl->getSpecialFile(0, m_impl->m_details);
 }
 std::optional<std::string> ModMetadata::getChangelog() const {
-    return m_impl->m_changelog;
+    return m_impl->getSpecialFile(1, m_impl->m_changelog);
 }
 std::optional<std::string> ModMetadata::getSupportInfo() const {
-    return m_impl->m_supportInfo;
+    return m_impl->getSpecialFile(2, m_impl->m_supportInfo);
 }
 std::optional<std::string> ModMetadata::getRepository() const {
     return m_impl->m_links.getSourceURL();
@@ -619,12 +738,15 @@ void ModMetadata::setDescription(std::optional<std::string> const& value) {
 }
 void ModMetadata::setDetails(std::optional<std::string> const& value) {
     m_impl->m_details = value;
+    m_impl->m_lazySpecialFiles &= ~(1 << 0);
 }
 void ModMetadata::setChangelog(std::optional<std::string> const& value) {
     m_impl->m_changelog = value;
+    m_impl->m_lazySpecialFiles &= ~(1 << 1);
 }
 void ModMetadata::setSupportInfo(std::optional<std::string> const& value) {
     m_impl->m_supportInfo = value;
+    m_impl->m_lazySpecialFiles &= ~(1 << 2);
 }
 void ModMetadata::setRepository(std::optional<std::string> const& value) {
     this->getLinksMut().getImpl()->m_source = value;
@@ -32,6 +32,13 @@ namespace geode {
         std::optional<std::string> m_details;
         std::optional<std::string> m_changelog;
         std::optional<std::string> m_supportInfo;
+        // about.md, changelog.md and support.md are only shown on the mod's 
+        // page, so instead of keeping them in memory for every mod, only which 
+        // ones exist is recorded and they're read when first needed. Values 
+        // set explicitly (like from the server) go in the optionals above
+        std::filesystem::path m_specialFilesSource;
+        bool m_specialFilesInZip = false;
+        uint8_t m_lazySpecialFiles = 0;
         ModMetadataLinks m_links;
         std::optional<IssuesInfo> m_issues;
         std::vector<Dependency> m_dependencies;
@@ -64,6 +71,7 @@ namespace geode {
         Result<> addSpecialFiles(utils::file::Unzip& zip);
 
         std::vector<std::pair<std::string, std::optional<std::string>*>> getSpecialFiles();
+        std::optional<std::string> getSpecialFile(size_t index, std::optional<std::string> const& value) const;
     };
 
     class ModMetadataImpl : public ModMetadata::Impl {
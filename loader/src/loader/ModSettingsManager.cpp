@@ -91,6 +91,7 @@ public:
     // update this by calling saveSettingValueToSave
     matjson::Value savedata;
     bool restartRequired = false;
+    bool unsavedChanges = false;
 
     void loadSettingValueFromSave(std::string const& key) {
         if (this->savedata.contains(key) && this->settings.contains(key)) {
@@ -191,6 +192,9 @@ ModSettingsManager::ModSettingsManager(ModSettingsManager&&) = default;
 void ModSettingsManager::markRestartRequired() {
     m_impl->restartRequired = true;
 }
+void ModSettingsManager::markChanged() {
+    m_impl->unsavedChanges = true;
+}
 
 Result<> ModSettingsManager::registerCustomSettingType(std::string_view type, SettingGenerator generator) {
     GEODE_UNWRAP(SharedSettingTypesPool::get().add(m_impl->modID, type, generator));
@@ -235,14 +239,17 @@ void ModSettingsManager::save(matjson::Value& json) {
     }
     // Doing this since `ModSettingsManager` is expected to manage savedata fully
     json = m_impl->savedata;
+    m_impl->unsavedChanges = false;
 }
 matjson::Value& ModSettingsManager::getSaveData() {
+    // The caller may modify the savedata through this
+    m_impl->unsavedChanges = true;
     return m_impl->savedata;
 }
 
 std::shared_ptr<SettingV3> ModSettingsManager::get(std::string_view key) {
-    auto id = std::string(key);
-    return m_impl->settings.count(id) ? m_impl->settings.at(id).v3 : nullptr;
+    auto it = m_impl->settings.find(std::string(key));
+    return it != m_impl->settings.end() ? it->second.v3 : nullptr;
 }
 std::shared_ptr<SettingValue> ModSettingsManager::getLegacy(std::string_view key) {
     auto id = std::string(key);
@@ -275,3 +282,6 @@ std::optional<Setting> ModSettingsManager::getLegacyDefinition(std::string_view
 bool ModSettingsManager::restartRequired() const {
     return m_impl->restartRequired;
 }
+bool ModSettingsManager::hasUnsavedChanges() const {
+    return m_impl->unsavedChanges;
+}
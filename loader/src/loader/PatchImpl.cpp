@@ -24,11 +24,8 @@ Patch::Impl::~Impl() {
 
 // TODO: replace this with a safe one
 static ByteVector readMemory(void* address, size_t amount) {
-    ByteVector ret;
-    for (size_t i = 0; i < amount; i++) {
-        ret.push_back(*reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(address) + i));
-    }
-    return ret;
+    auto begin = reinterpret_cast<uint8_t const*>(address);
+    return ByteVector(begin, begin + amount);
 }
 
 std::shared_ptr<Patch> Patch::Impl::create(void* address, const geode::ByteVector& patch) {
@@ -40,30 +37,44 @@ std::shared_ptr<Patch> Patch::Impl::create(void* address, const geode::ByteVecto
     });
 }
 
-std::vector<Patch::Impl*>& Patch::Impl::allEnabled() {
-    static std::vector<Patch::Impl*> vec;
-    return vec;
+std::map<uintptr_t, Patch::Impl*>& Patch::Impl::allEnabled() {
+    static std::map<uintptr_t, Patch::Impl*> map;
+    return map;
+}
+
+Result<> Patch::Impl::checkOverlaps(uintptr_t address, size_t size) {
+    if (size == 0 || allEnabled().empty()) {
+        return Ok();
+    }
+    auto const max = address + size - 1;
+    // The last patch starting at or before the end of this range is the 
+    // only one that can overlap it
+    auto it = allEnabled().upper_bound(max);
+    if (it == allEnabled().begin()) {
+        return Ok();
+    }
+    auto other = std::prev(it)->second;
+    auto const otherMax = other->getAddress() + other->m_patch.size() - 1;
+    if (otherMax < address) {
+        return Ok();
+    }
+    return Err(
+        "Failed to enable patch: overlaps patch at {} from {}",
+        other->m_address, other->getOwner() ? other->getOwner()->getID() : "<unknown>"
+    );
 }
 
 Result<> Patch::Impl::enable() {
-    auto const thisMin = this->getAddress();
-    auto const thisMax = this->getAddress() + this->m_patch.size() - 1;
-    // TODO: this feels slow. can be faster
-    for (const auto& other : allEnabled()) {
-        auto const otherMin = other->getAddress();
-        auto const otherMax = other->getAddress() + other->m_patch.size() - 1;
-        bool intersects = (thisMin >= otherMin && thisMin <= otherMax) || (thisMax >= otherMin && thisMax <= otherMax);
-        if (!intersects)
-            continue;
-        return Err(
-            "Failed to enable patch: overlaps patch at {} from {}",
-            other->m_address, other->getOwner()->getID()
-        );
+    // An empty patch doesn't change anything, and as it has no range it 
+    // could share its start address with another patch in allEnabled()
+    if (m_patch.empty()) {
+        return Err("Failed to enable patch: patch is empty");
     }
+    GEODE_UNWRAP(checkOverlaps(this->getAddress(), m_patch.size()));
     auto res = tulip::hook::writeMemory(m_address, m_patch.data(), m_patch.size());
     if (!res) return Err("Failed to enable patch: {}", res.unwrapErr());
     m_enabled = true;
-    allEnabled().push_back(this);
+    allEnabled().insert({ this->getAddress(), this });
     return Ok();
 }
 
@@ -72,9 +83,9 @@ Result<> Patch::Impl::disable() {
     if (!res) return Err("Failed to disable patch: {}", res.unwrapErr());
 
     m_enabled = false;
-    auto it = std::find(allEnabled().begin(), allEnabled().end(), this);
+    auto it = allEnabled().find(this->getAddress());
 
-    if (it == allEnabled().end()) {
+    if (it == allEnabled().end() || it->second != this) {
         return Err("Failed to disable patch: patch is already disabled");
     }
 
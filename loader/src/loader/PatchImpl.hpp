@@ -5,6 +5,7 @@
 #include <Geode/loader/Mod.hpp>
 #include "ModImpl.hpp"
 #include "ModPatch.hpp"
+#include <map>
 
 using namespace geode::prelude;
 
@@ -14,7 +15,12 @@ public:
     ~Impl();
 
     static std::shared_ptr<Patch> create(void* address, const ByteVector& patch);
-    static std::vector<Patch::Impl*>& allEnabled();
+    // Enabled patches by their start address. Enabled patches are never 
+    // empty and never overlap, so finding whether a range overlaps any of 
+    // them only requires looking at the patch starting right before the end 
+    // of the range
+    static std::map<uintptr_t, Patch::Impl*>& allEnabled();
+    static Result<> checkOverlaps(uintptr_t address, size_t size);
 
     Patch* m_self = nullptr;
     void* m_address;
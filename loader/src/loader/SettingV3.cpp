@@ -15,6 +15,8 @@ namespace enable_if_parsing {
         virtual ~Component() = default;
         virtual Result<> check() const = 0;
         virtual Result<> eval(std::string const& defaultModID) const = 0;
+        // Add the keys of the settings in the given mod this depends on
+        virtual void dependencies(std::string const& modID, std::vector<std::string>& out) const {}
     };
     struct RequireModLoaded final : public Component {
         std::string modID;
@@ -74,6 +76,11 @@ namespace enable_if_parsing {
             }
             return Err("Enable the mod {}", modName);
         }
+        void dependencies(std::string const& modID, std::vector<std::string>& out) const override {
+            if (this->modID == modID && !ranges::contains(out, settingID)) {
+                out.push_back(settingID);
+            }
+        }
     };
     struct RequireSavedValueEnabled final : public Component {
         std::string modID;
@@ -120,6 +127,9 @@ namespace enable_if_parsing {
             }
             return Ok();
         }
+        void dependencies(std::string const& modID, std::vector<std::string>& out) const override {
+            component->dependencies(modID, out);
+        }
     };
     struct RequireAll final : public Component {
         std::vector<std::unique_ptr<Component>> components;
@@ -140,6 +150,11 @@ namespace enable_if_parsing {
             }
             return Ok();
         }
+        void dependencies(std::string const& modID, std::vector<std::string>& out) const override {
+            for (auto& comp : components) {
+                comp->dependencies(modID, out);
+            }
+        }
     };
     struct RequireSome final : public Component {
         std::vector<std::unique_ptr<Component>> components;
@@ -166,6 +181,11 @@ namespace enable_if_parsing {
             }
             return err;
         }
+        void dependencies(std::string const& modID, std::vector<std::string>& out) const override {
+            for (auto& comp : components) {
+                comp->dependencies(modID, out);
+            }
+        }
     };
 
     static bool isComponentStartChar(char c) {
@@ -417,6 +437,231 @@ std::shared_ptr<SettingV3> SettingChangedEventV3::getSetting() const {
     return m_impl->setting;
 }
 
+namespace {
+    // Setting change listeners indexed by mod ID and setting key, so posting a 
+    // change only goes through the listeners of that specific setting (and 
+    // the ones listening to all of its mod's settings) instead of comparing 
+    // the IDs of every setting listener in the game. The locking scheme is 
+    // the same as DefaultEventListenerPool's.
+    // Events are passed on to the default pool afterwards, since listeners 
+    // from mods built against older headers (and any generic listeners for 
+    // SettingChangedEventV3) are registered there
+    class SettingChangedListenerPool final : public EventListenerPool {
+    private:
+        struct Location final {
+            std::string modID;
+            std::optional<std::string> key;
+        };
+        struct ModListeners final {
+            // Listeners for all of the mod's settings
+            std::vector<EventListenerProtocol*> all;
+            std::unordered_map<std::string, std::vector<EventListenerProtocol*>> keyed;
+        };
+
+        std::mutex m_mutex;
+        size_t m_locked = 0;
+        bool m_hasRemoved = false;
+        std::unordered_map<std::string, ModListeners> m_mods;
+        std::unordered_map<EventListenerProtocol*, Location> m_locations;
+        std::vector<std::pair<EventListenerProtocol*, Location>> m_toAdd;
+
+        static std::optional<Location> locationOf(EventListenerProtocol* listener) {
+            if (auto l = typeinfo_cast<EventListener<SettingChangedFilterV3>*>(listener)) {
+                return Location {
+                    .modID = l->getFilter().getModID(),
+                    .key = l->getFilter().getSettingKey(),
+                };
+            }
+            return std::nullopt;
+        }
+        std::vector<EventListenerProtocol*>& bucketFor(Location const& loc) {
+            auto& mod = m_mods[loc.modID];
+            return loc.key ? mod.keyed[*loc.key] : mod.all;
+        }
+
+        bool isRegistered(EventListenerProtocol* listener) const {
+            return m_locations.contains(listener) || ranges::contains(
+                m_toAdd, [listener](auto const& pair) { return pair.first == listener; }
+            );
+        }
+        void insert(EventListenerProtocol* listener, Location&& loc) {
+            if (m_locked) {
+                m_toAdd.push_back({ listener, std::move(loc) });
+                return;
+            }
+            // insert listeners at the start so new listeners get priority
+            auto& bucket = this->bucketFor(loc);
+            bucket.insert(bucket.begin(), listener);
+            m_locations.emplace(listener, std::move(loc));
+        }
+        void erase(EventListenerProtocol* listener) {
+            ranges::remove(m_toAdd, [listener](auto const& pair) { return pair.first == listener; });
+            auto it = m_locations.find(listener);
+            if (it == m_locations.end()) {
+                return;
+            }
+            // The bucket already exists so this doesn't modify the maps
+            auto& bucket = this->bucketFor(it->second);
+            if (m_locked) {
+                std::replace(bucket.begin(), bucket.end(), listener, static_cast<EventListenerProtocol*>(nullptr));
+                m_hasRemoved = true;
+            }
+            else {
+                ranges::remove(bucket, listener);
+            }
+            m_locations.erase(it);
+        }
+        // Only mutate the buckets once nothing is iterating them
+        void flush() {
+            if (m_hasRemoved) {
+                for (auto& [modID, mod] : m_mods) {
+                    ranges::remove(mod.all, nullptr);
+                    for (auto& [key, bucket] : mod.keyed) {
+                        ranges::remove(bucket, nullptr);
+                    }
+                }
+                m_hasRemoved = false;
+            }
+            auto toAdd = std::move(m_toAdd);
+            m_toAdd.clear();
+            for (auto& [listener, loc] : toAdd) {
+                this->insert(listener, std::move(loc));
+            }
+        }
+
+    public:
+        static SettingChangedListenerPool* get() {
+            static auto inst = new SettingChangedListenerPool();
+            return inst;
+        }
+
+        bool add(EventListenerProtocol* listener) override {
+            auto loc = locationOf(listener);
+            if (!loc) {
+                return false;
+            }
+            std::unique_lock lock(m_mutex);
+            if (this->isRegistered(listener)) {
+                return false;
+            }
+            this->insert(listener, std::move(*loc));
+            return true;
+        }
+        void remove(EventListenerProtocol* listener) override {
+            std::unique_lock lock(m_mutex);
+            this->erase(listener);
+        }
+        // Move a listener to the right bucket if its filter has been replaced
+        void update(EventListenerProtocol* listener) {
+            std::unique_lock lock(m_mutex);
+            if (!this->isRegistered(listener)) {
+                return;
+            }
+            auto loc = locationOf(listener);
+            this->erase(listener);
+            if (loc) {
+                this->insert(listener, std::move(*loc));
+            }
+        }
+
+        ListenerResult handle(Event* event) override {
+            auto ev = typeinfo_cast<SettingChangedEventV3*>(event);
+            if (!ev) {
+                return ListenerResult::Propagate;
+            }
+            if (this->handleKeyed(ev) == ListenerResult::Stop) {
+                return ListenerResult::Stop;
+            }
+            return DefaultEventListenerPool::get()->handle(event);
+        }
+
+    private:
+        ListenerResult handleKeyed(SettingChangedEventV3* event) {
+            auto setting = event->getSetting();
+            auto modID = setting->getModID();
+            auto key = setting->getKey();
+
+            std::unique_lock lock(m_mutex);
+            auto mod = m_mods.find(modID);
+            if (mod == m_mods.end()) {
+                return ListenerResult::Propagate;
+            }
+            auto res = ListenerResult::Propagate;
+            m_locked += 1;
+            auto keyed = mod->second.keyed.find(key);
+            for (auto bucket : {
+                keyed != mod->second.keyed.end() ? &keyed->second : nullptr,
+                &mod->second.all
+            }) {
+                // Buckets can't be resized while locked, but they can have 
+                // listeners nulled out, so iterate by index
+                for (size_t i = 0; bucket && i < bucket->size() && res != ListenerResult::Stop; i += 1) {
+                    auto h = bucket->at(i);
+                    lock.unlock();
+                    if (h && h->handle(event) == ListenerResult::Stop) {
+                        res = ListenerResult::Stop;
+                    }
+                    lock.lock();
+                }
+            }
+            m_locked -= 1;
+            if (m_locked == 0) {
+                this->flush();
+            }
+            return res;
+        }
+    };
+
+    // Changed settings that haven't been announced through a 
+    // SettingsCommittedEventV3 yet, grouped by mod in the order they changed
+    struct PendingSettingCommits final {
+        std::mutex mutex;
+        std::vector<std::pair<std::string, std::vector<std::shared_ptr<SettingV3>>>> mods;
+        bool queued = false;
+
+        static PendingSettingCommits& get() {
+            static auto inst = new PendingSettingCommits();
+            return *inst;
+        }
+
+        void add(std::shared_ptr<SettingV3> setting) {
+            std::unique_lock lock(mutex);
+            auto modID = setting->getModID();
+            auto mod = std::find_if(mods.begin(), mods.end(), [&](auto const& pair) {
+                return pair.first == modID;
+            });
+            if (mod == mods.end()) {
+                mods.push_back({ std::move(modID), {} });
+                mod = std::prev(mods.end());
+            }
+            if (!ranges::contains(mod->second, setting)) {
+                mod->second.push_back(setting);
+            }
+            // Post all of the changes made during this frame at once
+            if (!queued) {
+                queued = true;
+                Loader::get()->queueInMainThread([] {
+                    PendingSettingCommits::get().post();
+                });
+            }
+        }
+        void post() {
+            std::unique_lock lock(mutex);
+            auto toPost = std::move(mods);
+            mods.clear();
+            queued = false;
+            lock.unlock();
+            for (auto& [modID, settings] : toPost) {
+                SettingsCommittedEventV3(modID, settings).post();
+            }
+        }
+    };
+}
+
+EventListenerPool* SettingChangedEventV3::getPool() const {
+    return SettingChangedListenerPool::get();
+}
+
 class SettingChangedFilterV3::Impl final {
 public:
     std::string modID;
@@ -424,14 +669,33 @@ public:
 };
 
 ListenerResult SettingChangedFilterV3::handle(utils::MiniFunction<Callback> fn, SettingChangedEventV3* event) {
+    // SettingChangedListenerPool already only routes events to listeners 
+    // whose mod ID and key match, but listeners registered in the default 
+    // pool get every setting's changes
     if (
         event->getSetting()->getModID() == m_impl->modID &&
-        !m_impl->settingKey || event->getSetting()->getKey() == m_impl->settingKey
+        (!m_impl->settingKey || event->getSetting()->getKey() == m_impl->settingKey)
     ) {
         fn(event->getSetting());
     }
     return ListenerResult::Propagate;
 }
+EventListenerPool* SettingChangedFilterV3::getPool() const {
+    return SettingChangedListenerPool::get();
+}
+void SettingChangedFilterV3::setListener(EventListenerProtocol* listener) {
+    m_listener = listener;
+    if (listener) {
+        SettingChangedListenerPool::get()->update(listener);
+    }
+}
+
+std::string const& SettingChangedFilterV3::getModID() const {
+    return m_impl->modID;
+}
+std::optional<std::string> const& SettingChangedFilterV3::getSettingKey() const {
+    return m_impl->settingKey;
+}
 
 SettingChangedFilterV3::SettingChangedFilterV3(
     std::string const& modID,
@@ -447,6 +711,37 @@ SettingChangedFilterV3::SettingChangedFilterV3(Mod* mod, std::optional<std::stri
 
 SettingChangedFilterV3::SettingChangedFilterV3(SettingChangedFilterV3 const&) = default;
 
+class SettingsCommittedEventV3::Impl final {
+public:
+    std::string modID;
+    std::vector<std::shared_ptr<SettingV3>> settings;
+};
+
+SettingsCommittedEventV3::SettingsCommittedEventV3(std::string const& modID, std::vector<std::shared_ptr<SettingV3>> const& settings)
+  : m_impl(std::make_shared<Impl>())
+{
+    m_impl->modID = modID;
+    m_impl->settings = settings;
+}
+
+std::string SettingsCommittedEventV3::getModID() const {
+    return m_impl->modID;
+}
+std::vector<std::shared_ptr<SettingV3>> const& SettingsCommittedEventV3::getSettings() const {
+    return m_impl->settings;
+}
+
+ListenerResult SettingsCommittedFilterV3::handle(utils::MiniFunction<Callback> fn, SettingsCommittedEventV3* event) {
+    if (event->getModID() == m_modID) {
+        fn(event->getSettings());
+    }
+    return ListenerResult::Propagate;
+}
+
+SettingsCommittedFilterV3::SettingsCommittedFilterV3(std::string const& modID) : m_modID(modID) {}
+SettingsCommittedFilterV3::SettingsCommittedFilterV3(Mod* mod) : SettingsCommittedFilterV3(mod->getID()) {}
+SettingsCommittedFilterV3::SettingsCommittedFilterV3(SettingsCommittedFilterV3 const&) = default;
+
 EventListener<SettingChangedFilterV3>* geode::listenForAllSettingChanges(
     std::function<void(std::shared_ptr<SettingV3>)> const& callback,
     Mod* mod
@@ -544,6 +839,13 @@ bool SettingV3::shouldEnable() const {
     }
     return true;
 }
+std::vector<std::string> SettingV3::getEnableIfDependencies() const {
+    std::vector<std::string> res;
+    if (m_impl->enableIfTree) {
+        m_impl->enableIfTree->dependencies(m_impl->modID, res);
+    }
+    return res;
+}
 std::optional<std::string> SettingV3::getEnableIfDescription() const {
     if (m_impl->enableIfDescription) {
         return *m_impl->enableIfDescription;
@@ -569,10 +871,14 @@ Mod* SettingV3::getMod() const {
 
 void SettingV3::markChanged() {
     auto manager = ModSettingsManager::from(this->getMod());
-    if (m_impl->requiresRestart) {
+    if (manager) {
+        manager->markChanged();
+    }
+    if (manager && m_impl->requiresRestart) {
         manager->markRestartRequired();
     }
     SettingChangedEventV3(shared_from_this()).post();
+    PendingSettingCommits::get().add(shared_from_this());
     if (manager) {
         // Use ModSettingsManager rather than convertToLegacyValue since it 
         // caches the result and we want to have that for performance
@@ -0,0 +1,146 @@
+#include "StartupTrace.hpp"
+
+#include <Geode/loader/Loader.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/general.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace geode::prelude;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic_bool s_enabled = false;
+
+    struct TraceEvent final {
+        // Chrome trace event phase: B/E for scopes, b/e for spans
+        char phase;
+        std::string_view category;
+        std::string name;
+        Clock::time_point time;
+    };
+
+    // The only lock taken while recording is the thread's own buffer's,
+    // which is uncontended unless the trace is being exported
+    struct ThreadBuffer final {
+        std::mutex mutex;
+        size_t id;
+        std::string name;
+        std::vector<TraceEvent> events;
+    };
+
+    struct Buffers final {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> threads;
+        std::atomic_bool stopped = false;
+        Clock::time_point const start = Clock::now();
+
+        static Buffers& get() {
+            static auto inst = new Buffers();
+            return *inst;
+        }
+    };
+
+    ThreadBuffer& threadBuffer() {
+        thread_local auto buffer = [] {
+            auto buffer = std::make_shared<ThreadBuffer>();
+            // Threads name themselves before doing anything worth tracing,
+            // so the name can be grabbed once here
+            buffer->name = utils::thread::getName();
+            std::unique_lock lock(Buffers::get().mutex);
+            buffer->id = Buffers::get().threads.size() + 1;
+            Buffers::get().threads.push_back(buffer);
+            return buffer;
+        }();
+        return *buffer;
+    }
+
+    void record(char phase, std::string_view category, std::string&& name) {
+        if (!StartupTrace::isEnabled() || Buffers::get().stopped) {
+            return;
+        }
+        auto& buffer = threadBuffer();
+        std::unique_lock lock(buffer.mutex);
+        buffer.events.push_back({
+            .phase = phase,
+            .category = category,
+            .name = std::move(name),
+            .time = Clock::now(),
+        });
+    }
+}
+
+void StartupTrace::setEnabled(bool enabled) {
+    s_enabled = enabled;
+}
+bool StartupTrace::isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void StartupTrace::begin(std::string_view category, std::string name) {
+    record('B', category, std::move(name));
+}
+void StartupTrace::end(std::string_view category) {
+    record('E', category, "");
+}
+
+void StartupTrace::beginSpan(std::string_view category, std::string name) {
+    record('b', category, std::move(name));
+}
+void StartupTrace::endSpan(std::string_view category, std::string name) {
+    record('e', category, std::move(name));
+}
+
+matjson::Value StartupTrace::toJSON() {
+    auto& buffers = Buffers::get();
+    buffers.stopped = true;
+
+    std::unique_lock lock(buffers.mutex);
+    auto threads = buffers.threads;
+    lock.unlock();
+
+    auto events = matjson::Array();
+    for (auto& thread : threads) {
+        std::unique_lock threadLock(thread->mutex);
+        events.push_back(matjson::Object {
+            { "ph", "M" },
+            { "name", "thread_name" },
+            { "pid", 1 },
+            { "tid", static_cast<double>(thread->id) },
+            { "args", matjson::Object { { "name", thread->name } } },
+        });
+        for (auto& event : thread->events) {
+            auto obj = matjson::Object {
+                { "ph", std::string(1, event.phase) },
+                { "cat", std::string(event.category) },
+                { "pid", 1 },
+                { "tid", static_cast<double>(thread->id) },
+                { "ts", std::chrono::duration<double, std::micro>(event.time - buffers.start).count() },
+            };
+            // Ends of scopes are matched to their begin by nesting
+            if (event.phase != 'E') {
+                obj["name"] = event.name;
+            }
+            // Spans are matched by category and ID instead
+            if (event.phase == 'b' || event.phase == 'e') {
+                obj["id"] = event.name;
+            }
+            events.push_back(std::move(obj));
+        }
+    }
+    return matjson::Object {
+        { "traceEvents", events },
+        { "displayTimeUnit", "ms" },
+    };
+}
+
+Result<> StartupTrace::save(std::filesystem::path const& dir) {
+    auto path = dir / "startup-trace.json";
+    GEODE_UNWRAP(file::writeString(path, StartupTrace::toJSON().dump(matjson::NO_INDENTATION)));
+    log::info("Saved startup trace to {}", path);
+    return Ok();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Geode/utils/Result.hpp>
+#include <fmt/format.h>
+#include <matjson.hpp>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace geode {
+    // Records what the loader is doing during startup when the game is
+    // launched with `--geode:trace-startup`, and writes it to the logs
+    // directory as a Chrome trace (which Perfetto and chrome://tracing can
+    // open) once the game has finished loading.
+    // Every thread records into its own buffer, so recording from the unzip
+    // and decoder threads doesn't contend with the main thread. When tracing
+    // is disabled, recording costs a single branch
+    class StartupTrace final {
+    public:
+        // Called once the launch arguments have been read, before anything 
+        // is recorded
+        static void setEnabled(bool enabled);
+        static bool isEnabled();
+
+        // Record the start and end of something happening on this thread.
+        // Begins and ends must be nested, which `Scope` takes care of.
+        // The category has to be a string literal
+        static void begin(std::string_view category, std::string name);
+        static void end(std::string_view category);
+
+        // Record something that spans multiple frames, such as a loading
+        // phase. Spans are shown on their own track, so they don't have to
+        // be nested with anything else. The span is identified by its name
+        static void beginSpan(std::string_view category, std::string name);
+        static void endSpan(std::string_view category, std::string name);
+
+        // Stop recording and get everything recorded so far in the Chrome
+        // trace event format
+        static matjson::Value toJSON();
+        // Stop recording and write the trace to `startup-trace.json` in
+        // the given directory
+        static Result<> save(std::filesystem::path const& dir);
+
+        // Records everything that happens on this thread for as long as it's
+        // alive. The name is only formatted if tracing is enabled
+        class Scope final {
+        private:
+            std::string_view m_category;
+            bool m_active;
+
+        public:
+            template <class... Args>
+            Scope(std::string_view category, fmt::format_string<Args...> format, Args&&... args)
+              : m_category(category), m_active(StartupTrace::isEnabled())
+            {
+                if (m_active) {
+                    StartupTrace::begin(category, fmt::format(format, std::forward<Args>(args)...));
+                }
+            }
+            ~Scope() {
+                if (m_active) {
+                    StartupTrace::end(m_category);
+                }
+            }
+
+            Scope(Scope const&) = delete;
+            Scope& operator=(Scope const&) = delete;
+        };
+    };
+}
@@ -0,0 +1,122 @@
+#include "DownloadChunks.hpp"
+#include <algorithm>
+
+using namespace server;
+
+size_t DownloadChunkRange::last() const {
+    return offset + size - 1;
+}
+
+bool server::shouldDownloadInChunks(
+    std::optional<size_t> size, std::optional<std::string_view> acceptRanges, size_t minSize
+) {
+    return size && *size >= minSize && acceptRanges == "bytes";
+}
+
+std::vector<DownloadChunkRange> server::planDownloadChunks(size_t size, size_t chunkSize) {
+    std::vector<DownloadChunkRange> chunks;
+    if (chunkSize == 0) {
+        return chunks;
+    }
+    chunks.reserve((size + chunkSize - 1) / chunkSize);
+    for (size_t offset = 0; offset < size; offset += chunkSize) {
+        chunks.push_back({
+            .offset = offset,
+            .size = std::min(chunkSize, size - offset),
+        });
+    }
+    return chunks;
+}
+
+uint8_t server::downloadPercentage(size_t downloaded, size_t total) {
+    if (total == 0) {
+        return 0;
+    }
+    return static_cast<uint8_t>(std::min<size_t>(downloaded, total) * 100 / total);
+}
+
+ChunkedDownload::ChunkedDownload(size_t size, size_t chunkSize, size_t maxParallel)
+  : m_size(size), m_maxParallel(maxParallel)
+{
+    for (auto const& range : planDownloadChunks(size, chunkSize)) {
+        m_chunks.push_back({ .range = range });
+    }
+}
+
+size_t ChunkedDownload::getChunkCount() const {
+    return m_chunks.size();
+}
+DownloadChunkRange const& ChunkedDownload::getRange(size_t index) const {
+    return m_chunks.at(index).range;
+}
+
+void ChunkedDownload::markFinished(size_t index) {
+    auto& chunk = m_chunks.at(index);
+    chunk.state = State::Finished;
+    chunk.downloaded = chunk.range.size;
+}
+
+std::vector<size_t> ChunkedDownload::startNext() {
+    size_t running = std::count_if(m_chunks.begin(), m_chunks.end(), [](auto const& chunk) {
+        return chunk.state == State::Running;
+    });
+    std::vector<size_t> started;
+    for (size_t i = 0; i < m_chunks.size() && running < m_maxParallel; i += 1) {
+        if (m_chunks[i].state == State::Pending) {
+            m_chunks[i].state = State::Running;
+            started.push_back(i);
+            running += 1;
+        }
+    }
+    return started;
+}
+
+void ChunkedDownload::onProgress(size_t index, size_t downloaded) {
+    auto& chunk = m_chunks.at(index);
+    if (chunk.state == State::Running) {
+        chunk.downloaded = std::min(downloaded, chunk.range.size);
+    }
+}
+
+ChunkedDownload::Response ChunkedDownload::onResponse(size_t index, int code, size_t size) {
+    auto& chunk = m_chunks.at(index);
+    if (chunk.state != State::Running) {
+        return Response::Failed;
+    }
+    // A 200 instead of a 206 means the server ignored the range
+    if (code == 200) {
+        return Response::WholeFile;
+    }
+    if (code != 206 || size != chunk.range.size) {
+        return Response::Failed;
+    }
+    this->markFinished(index);
+    return Response::Finished;
+}
+
+void ChunkedDownload::onStopped(size_t index) {
+    auto& chunk = m_chunks.at(index);
+    if (chunk.state == State::Running) {
+        chunk.state = State::Pending;
+        chunk.downloaded = 0;
+    }
+}
+
+size_t ChunkedDownload::getFinishedCount() const {
+    return std::count_if(m_chunks.begin(), m_chunks.end(), [](auto const& chunk) {
+        return chunk.state == State::Finished;
+    });
+}
+size_t ChunkedDownload::getDownloaded() const {
+    size_t downloaded = 0;
+    for (auto const& chunk : m_chunks) {
+        downloaded += chunk.downloaded;
+    }
+    return downloaded;
+}
+uint8_t ChunkedDownload::getPercentage() const {
+    return downloadPercentage(this->getDownloaded(), m_size);
+}
+bool ChunkedDownload::isFinished() const {
+    return this->getFinishedCount() == m_chunks.size();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace server {
+    // A part of a download that is fetched with a single range request
+    struct DownloadChunkRange final {
+        size_t offset;
+        size_t size;
+
+        // HTTP byte ranges are inclusive, so this is the last byte of the 
+        // chunk rather than one past it
+        size_t last() const;
+    };
+
+    // Whether a download is worth splitting into chunks, based on the 
+    // Content-Length and Accept-Ranges headers of the response to a HEAD 
+    // request for it
+    bool shouldDownloadInChunks(
+        std::optional<size_t> size, std::optional<std::string_view> acceptRanges, size_t minSize
+    );
+    // Split a download into consecutive chunks of `chunkSize` bytes, except 
+    // for the last one which gets whatever is left over
+    std::vector<DownloadChunkRange> planDownloadChunks(size_t size, size_t chunkSize);
+    uint8_t downloadPercentage(size_t downloaded, size_t total);
+
+    // Keeps track of which chunks of a download are finished, which are 
+    // being fetched and which are still left. This only decides what to 
+    // request next and what a response means; making the requests and 
+    // storing the chunks is up to the caller
+    class ChunkedDownload final {
+    public:
+        enum class Response {
+            // The chunk arrived and can be stored
+            Finished,
+            // The server ignored the range and sent the whole file, so the 
+            // download has to be done in one piece instead
+            WholeFile,
+            // The response was an error or didn't match the requested range
+            Failed,
+        };
+
+    private:
+        enum class State {
+            Pending,
+            Running,
+            Finished,
+        };
+        struct Chunk final {
+            DownloadChunkRange range;
+            State state = State::Pending;
+            size_t downloaded = 0;
+        };
+
+        std::vector<Chunk> m_chunks;
+        size_t m_size;
+        size_t m_maxParallel;
+
+    public:
+        ChunkedDownload(size_t size, size_t chunkSize, size_t maxParallel);
+
+        size_t getChunkCount() const;
+        DownloadChunkRange const& getRange(size_t index) const;
+
+        // Mark a chunk as already downloaded, for resuming a download from 
+        // the chunks kept by a previous attempt
+        void markFinished(size_t index);
+        // The chunks that should be requested now. These are marked as 
+        // running, so each one is only handed out once
+        std::vector<size_t> startNext();
+        void onProgress(size_t index, size_t downloaded);
+        Response onResponse(size_t index, int code, size_t size);
+        // Put a running chunk back to be requested again later
+        void onStopped(size_t index);
+
+        size_t getFinishedCount() const;
+        size_t getDownloaded() const;
+        uint8_t getPercentage() const;
+        bool isFinished() const;
+    };
+}
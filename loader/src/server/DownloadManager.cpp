@@ -1,8 +1,10 @@
 #include "DownloadManager.hpp"
+#include "DownloadChunks.hpp"
 #include "Geode/loader/Mod.hpp"
 #include <Geode/loader/Dirs.hpp>
 #include <Geode/utils/map.hpp>
 #include <optional>
+#include <unordered_set>
 #include <hash/hash.hpp>
 
 using namespace server;
@@ -92,53 +94,69 @@ public:
         });
     }
 
-    void confirm() {
-        auto confirm = std::get_if<DownloadStatusConfirm>(&m_status);
-        if (!confirm) return;
+    // Downloads larger than this are split into chunks that are fetched in 
+    // parallel using range requests. Finished chunks are kept in the temp 
+    // directory, so a cancelled or failed download continues from where it 
+    // left off instead of starting over from zero
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+    static constexpr size_t MAX_PARALLEL_CHUNKS = 4;
+    static constexpr size_t MIN_CHUNKED_SIZE = 4 * CHUNK_SIZE;
 
-        auto version = confirm->version;
-        m_status = DownloadStatusDownloading {
-            .percentage = 0,
-        };
+    EventListener<web::WebTask> m_sizeListener;
+    std::optional<ChunkedDownload> m_chunked;
+    // One listener per chunk, indexed the same as the chunks in m_chunked
+    std::vector<std::unique_ptr<EventListener<web::WebTask>>> m_chunkListeners;
+    // The URL the download URL redirects to. The download URL itself counts 
+    // downloads, so it's only requested once and all of the range requests 
+    // go to wherever it points to
+    std::string m_rangeURL;
+
+    std::filesystem::path getPartialDir() const {
+        return dirs::getTempDir() / "downloads" / m_id;
+    }
+
+    void install(ServerModVersion const& version, ByteVector const& data) {
+        if (auto actualHash = ::calculateHash(data); actualHash != version.hash) {
+            log::error("Failed to download {}, hash mismatch ({} != {})", m_id, actualHash, version.hash);
+            m_status = DownloadStatusError {
+                .details = "Hash mismatch, downloaded file did not match what was expected",
+            };
+            return;
+        }
 
-        m_downloadListener.bind([this, hash = version.hash, version = version](web::WebTask::Event* event) {
+        bool removingInstalledWasError = false;
+        std::string id = m_replacesMod.has_value() ? m_replacesMod.value() : m_id;
+        if (auto mod = Loader::get()->getInstalledMod(id)) {
+            std::error_code ec;
+            std::filesystem::remove(mod->getPackagePath(), ec);
+            if (ec) {
+                removingInstalledWasError = true;
+                m_status = DownloadStatusError {
+                    .details = fmt::format("Unable to delete existing .geode package (code {})", ec),
+                };
+            }
+        }
+        // If this was an update, delete the old file first
+        if (!removingInstalledWasError) {
+            auto ok = file::writeBinary(dirs::getModsDir() / (m_id + ".geode"), data);
+            if (!ok) {
+                m_status = DownloadStatusError {
+                    .details = ok.unwrapErr(),
+                };
+            }
+            else {
+                m_status = DownloadStatusDone {
+                    .version = version
+                };
+            }
+        }
+    }
+
+    void downloadWhole(ServerModVersion const& version) {
+        m_downloadListener.bind([this, version = version](web::WebTask::Event* event) {
             if (auto value = event->getValue()) {
                 if (value->ok()) {
-                    if (auto actualHash = ::calculateHash(value->data()); actualHash != hash) {
-                        log::error("Failed to download {}, hash mismatch ({} != {})", m_id, actualHash, hash);
-                        m_status = DownloadStatusError {
-                            .details = "Hash mismatch, downloaded file did not match what was expected",
-                        };
-                        ModDownloadEvent(m_id).post();
-                        return;
-                    }
-
-                    bool removingInstalledWasError = false;
-                    std::string id = m_replacesMod.has_value() ? m_replacesMod.value() : m_id;
-                    if (auto mod = Loader::get()->getInstalledMod(id)) {
-                        std::error_code ec;
-                        std::filesystem::remove(mod->getPackagePath(), ec);
-                        if (ec) {
-                            removingInstalledWasError = true;
-                            m_status = DownloadStatusError {
-                                .details = fmt::format("Unable to delete existing .geode package (code {})", ec),
-                            };
-                        }
-                    }
-                    // If this was an update, delete the old file first
-                    if (!removingInstalledWasError) {
-                        auto ok = file::writeBinary(dirs::getModsDir() / (m_id + ".geode"), value->data());
-                        if (!ok) {
-                            m_status = DownloadStatusError {
-                                .details = ok.unwrapErr(),
-                            };
-                        }
-                        else {
-                            m_status = DownloadStatusDone {
-                                .version = version
-                            };
-                        }
-                    }
+                    this->install(version, value->data());
                 }
                 else {
                     m_status = DownloadStatusError {
@@ -160,6 +178,213 @@ public:
         auto req = web::WebRequest();
         req.userAgent(getServerUserAgent());
         m_downloadListener.setFilter(req.get(version.downloadURL));
+    }
+
+    Result<> preparePartialDir(ServerModVersion const& version, size_t size) {
+        auto dir = this->getPartialDir();
+        auto metaPath = dir / "download.json";
+
+        // Chunks left over from a previous attempt can only be reused if 
+        // they are for the exact same file
+        bool reusable = false;
+        if (auto meta = file::readJson(metaPath)) {
+            auto json = meta.unwrap();
+            reusable = 
+                json.contains("hash") && json["hash"].is_string() &&
+                json["hash"].as_string() == version.hash &&
+                json.contains("size") && json["size"].is_number() &&
+                json["size"].as_double() == static_cast<double>(size) &&
+                json.contains("chunk-size") && json["chunk-size"].is_number() &&
+                json["chunk-size"].as_double() == static_cast<double>(CHUNK_SIZE);
+        }
+        if (!reusable) {
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+        }
+        GEODE_UNWRAP(file::createDirectoryAll(dir));
+        if (!reusable) {
+            auto json = matjson::Object {
+                { "hash", version.hash },
+                { "size", static_cast<double>(size) },
+                { "chunk-size", static_cast<double>(CHUNK_SIZE) },
+            };
+            GEODE_UNWRAP(file::writeString(metaPath, matjson::Value(json).dump()));
+        }
+        return Ok();
+    }
+
+    void downloadChunked(ServerModVersion const& version, size_t size) {
+        if (auto res = this->preparePartialDir(version, size); !res) {
+            log::warn("Unable to prepare partial download of {}, downloading normally: {}", m_id, res.unwrapErr());
+            return this->downloadWhole(version);
+        }
+
+        auto& chunked = m_chunked.emplace(size, CHUNK_SIZE, MAX_PARALLEL_CHUNKS);
+        m_chunkListeners.clear();
+        auto dir = this->getPartialDir();
+        for (size_t i = 0; i < chunked.getChunkCount(); i += 1) {
+            m_chunkListeners.push_back(std::make_unique<EventListener<web::WebTask>>());
+
+            // Skip chunks that were already finished on a previous attempt
+            std::error_code ec;
+            auto path = dir / fmt::format("{}.part", i);
+            if (std::filesystem::file_size(path, ec) == chunked.getRange(i).size && !ec) {
+                chunked.markFinished(i);
+            }
+        }
+
+        if (auto reused = chunked.getFinishedCount()) {
+            log::info("Resuming download of {} ({}/{} chunks already downloaded)", m_id, reused, chunked.getChunkCount());
+        }
+        this->continueChunked(version);
+    }
+
+    void continueChunked(ServerModVersion const& version) {
+        if (m_chunked->isFinished()) {
+            return this->finishChunked(version);
+        }
+
+        m_status = DownloadStatusDownloading {
+            .percentage = m_chunked->getPercentage(),
+        };
+
+        for (auto i : m_chunked->startNext()) {
+            auto& listener = *m_chunkListeners.at(i);
+            listener.bind([this, i, version](web::WebTask::Event* event) {
+                if (!std::holds_alternative<DownloadStatusDownloading>(m_status)) {
+                    return;
+                }
+                if (auto value = event->getValue()) {
+                    auto data = value->data();
+                    m_chunkListeners.at(i)->setFilter(web::WebTask());
+                    switch (m_chunked->onResponse(i, value->code(), data.size())) {
+                        case ChunkedDownload::Response::Finished: {
+                            auto path = this->getPartialDir() / fmt::format("{}.part", i);
+                            if (auto ok = file::writeBinary(path, data); !ok) {
+                                this->failChunked(ok.unwrapErr());
+                            }
+                            else {
+                                this->continueChunked(version);
+                            }
+                        } break;
+
+                        case ChunkedDownload::Response::WholeFile: {
+                            log::warn("Server ignored range request for {}, downloading normally", m_id);
+                            this->cancelChunks();
+                            std::error_code ec;
+                            std::filesystem::remove_all(this->getPartialDir(), ec);
+                            this->downloadWhole(version);
+                        } break;
+
+                        case ChunkedDownload::Response::Failed: {
+                            this->failChunked(fmt::format(
+                                "Server did not respond with the requested range (code {})", value->code()
+                            ));
+                        } break;
+                    }
+                }
+                else if (auto progress = event->getProgress()) {
+                    m_chunked->onProgress(i, progress->downloaded());
+                    m_status = DownloadStatusDownloading {
+                        .percentage = m_chunked->getPercentage(),
+                    };
+                }
+                else if (event->isCancelled()) {
+                    this->cancelChunks();
+                    m_status = DownloadStatusCancelled();
+                }
+                ModDownloadEvent(m_id).post();
+            });
+
+            auto const& range = m_chunked->getRange(i);
+            auto req = web::WebRequest();
+            req.userAgent(getServerUserAgent());
+            req.downloadRange({ range.offset, range.last() });
+            listener.setFilter(req.get(m_rangeURL));
+        }
+    }
+
+    void finishChunked(ServerModVersion const& version) {
+        auto dir = this->getPartialDir();
+        ByteVector data;
+        data.reserve(m_chunked->getDownloaded());
+        for (size_t i = 0; i < m_chunked->getChunkCount(); i += 1) {
+            auto chunk = file::readBinary(dir / fmt::format("{}.part", i));
+            if (!chunk) {
+                return this->failChunked(chunk.unwrapErr());
+            }
+            auto bytes = chunk.unwrap();
+            data.insert(data.end(), bytes.begin(), bytes.end());
+        }
+
+        // The chunks are no longer needed once reassembled; and if the hash 
+        // doesn't match, resuming from them next time would be pointless 
+        // anyway
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+
+        this->install(version, data);
+    }
+
+    void failChunked(std::string const& details) {
+        log::error("Failed to download {}: {}", m_id, details);
+        this->cancelChunks();
+        m_status = DownloadStatusError {
+            .details = details,
+        };
+    }
+
+    void cancelChunks() {
+        // Finished chunks are kept on disk so retrying can resume from them. 
+        // Note that this may be called from within a chunk's listener, so the 
+        // listeners themselves are only cleared when the next attempt starts
+        for (size_t i = 0; i < m_chunkListeners.size(); i += 1) {
+            auto& listener = *m_chunkListeners[i];
+            listener.getFilter().cancel();
+            listener.setFilter(web::WebTask());
+            m_chunked->onStopped(i);
+        }
+    }
+
+    void confirm() {
+        auto confirm = std::get_if<DownloadStatusConfirm>(&m_status);
+        if (!confirm) return;
+
+        auto version = confirm->version;
+        m_status = DownloadStatusDownloading {
+            .percentage = 0,
+        };
+
+        // Check the size of the file and whether the server supports range 
+        // requests first to figure out if it should be downloaded in chunks. 
+        // This also follows the download URL's redirect, so the chunks can 
+        // be requested from where it ends up
+        m_sizeListener.bind([this, version = version](web::WebTask::Event* event) {
+            if (auto value = event->getValue()) {
+                std::optional<size_t> size;
+                if (auto length = value->header("Content-Length")) {
+                    size = numFromString<size_t>(*length).ok();
+                }
+                auto ranges = value->header("Accept-Ranges");
+                if (value->ok() && shouldDownloadInChunks(size, ranges, MIN_CHUNKED_SIZE)) {
+                    m_rangeURL = value->url().empty() ? version.downloadURL : value->url();
+                    this->downloadChunked(version, *size);
+                }
+                else {
+                    this->downloadWhole(version);
+                }
+                m_sizeListener.setFilter(web::WebTask());
+            }
+            else if (event->isCancelled()) {
+                m_status = DownloadStatusCancelled();
+                ModDownloadEvent(m_id).post();
+            }
+        });
+
+        auto req = web::WebRequest();
+        req.userAgent(getServerUserAgent());
+        req.transferBody(false);
+        m_sizeListener.setFilter(req.get(version.downloadURL));
         ModDownloadEvent(m_id).post();
     }
 };
@@ -211,6 +436,46 @@ public:
     std::unordered_map<std::string, ModDownload> m_downloads;
     Task<std::monostate> m_updateAllTask;
 
+    // Mod ID -> versions of that mod that some installed mod or finished 
+    // download is incompatible with, so that checkAutoConfirm doesn't have 
+    // to go through the metadata of every mod on every download event
+    std::unordered_map<std::string, std::vector<ComparableVersionInfo>> m_incompatibilities;
+    std::unordered_set<std::string> m_indexedDownloads;
+    bool m_indexedInstalledMods = false;
+
+    void addIncompatibilities(ModMetadata const& metadata) {
+        for (auto& inc : metadata.getIncompatibilities()) {
+            m_incompatibilities[inc.id].push_back(inc.version);
+        }
+    }
+    void updateIncompatibilities() {
+        // Installed mods can't change without a restart
+        if (!m_indexedInstalledMods) {
+            m_indexedInstalledMods = true;
+            for (auto mod : Loader::get()->getAllMods()) {
+                this->addIncompatibilities(mod->getMetadata());
+            }
+        }
+        // Finished downloads can't be retried or dismissed, so they only 
+        // need to be indexed once
+        for (auto& [id, download] : m_downloads) {
+            if (auto done = std::get_if<DownloadStatusDone>(&download.m_impl->m_status)) {
+                if (m_indexedDownloads.insert(id).second) {
+                    this->addIncompatibilities(done->version.metadata);
+                }
+            }
+        }
+    }
+    bool isIncompatible(std::string const& id, std::optional<VersionInfo> const& version) const {
+        auto it = m_incompatibilities.find(id);
+        if (it == m_incompatibilities.end()) {
+            return false;
+        }
+        return std::any_of(it->second.begin(), it->second.end(), [&](ComparableVersionInfo const& range) {
+            return !version.has_value() || range.compare(*version);
+        });
+    }
+
     void cancelOrphanedDependencies() {
         // "This doesn't handle circular dependencies!!!!"
         // Well OK and the human skull doesn't handle the 5000 newtons
@@ -239,6 +504,9 @@ void ModDownload::cancel() {
         m_impl->m_infoListener.setFilter(ServerRequest<ServerModVersion>());
         m_impl->m_downloadListener.getFilter().cancel();
         m_impl->m_downloadListener.setFilter({});
+        m_impl->m_sizeListener.getFilter().cancel();
+        m_impl->m_sizeListener.setFilter({});
+        m_impl->cancelChunks();
 
         // Cancel any dependencies of this mod left over (unless some other
         // installation depends on them still)
@@ -312,42 +580,31 @@ void ModDownloadManager::dismissAll() {
     ModDownloadEvent("").post();
 }
 bool ModDownloadManager::checkAutoConfirm() {
-    for (auto& [_, download] :  m_impl->m_downloads) {
-        auto status = download.getStatus();
+    m_impl->updateIncompatibilities();
+
+    for (auto& [id, download] : m_impl->m_downloads) {
+        auto& status = download.m_impl->m_status;
         if (auto confirm = std::get_if<server::DownloadStatusConfirm>(&status)) {
-            for (auto inc : confirm->version.metadata.getIncompatibilities()) {
+            auto version = download.getVersion();
+            for (auto& inc : confirm->version.metadata.getIncompatibilities()) {
                 // If some mod has an incompatability that is installed,
                 // we need to ask for confirmation
-                if (inc.mod && (!download.getVersion().has_value() || inc.version.compare(download.getVersion().value()))) {
+                if (inc.mod && (!version.has_value() || inc.version.compare(version.value()))) {
                     return false;
                 }
-                for (auto download : ModDownloadManager::get()->getDownloads()) {
-                    if (download.isDone() && inc.id == download.getID() && (!download.getVersion().has_value() || inc.version.compare(download.getVersion().value()))) {
+                // Same goes for mods that have just been downloaded
+                auto other = m_impl->m_downloads.find(inc.id);
+                if (other != m_impl->m_downloads.end() && other->second.isDone()) {
+                    auto otherVersion = other->second.getVersion();
+                    if (!otherVersion.has_value() || inc.version.compare(otherVersion.value())) {
                         return false;
                     }
                 }
             }
-            // If some installed mod is incompatible with this one,
-            // we need to ask for confirmation
-            for (auto mod : Loader::get()->getAllMods()) {
-                for (auto inc : mod->getMetadata().getIncompatibilities()) {
-                    if (inc.id == download.getID() && (!download.getVersion().has_value() || inc.version.compare(download.getVersion().value()))) {
-                        return false;
-                    }
-                }
-            }
-
-            // If some newly downloaded mods are incompatible with this one, 
-            // we need to ask for confirmation
-            for (auto download : ModDownloadManager::get()->getDownloads()) {
-                auto status = download.getStatus();
-                if (auto done = std::get_if<DownloadStatusDone>(&status)) {
-                    for (auto inc : done->version.metadata.getIncompatibilities()) {
-                        if (inc.id == download.getID() && inc.version.compare(done->version.metadata.getVersion())) {
-                            return false;
-                        }
-                    }
-                }
+            // If some installed or newly downloaded mod is incompatible with 
+            // this one, we need to ask for confirmation
+            if (m_impl->isIncompatible(id, version)) {
+                return false;
             }
         }
         // If there are mods we aren't sure about yet, we can't auto-confirm
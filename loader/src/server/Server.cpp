@@ -1,4 +1,5 @@
 #include "Server.hpp"
+#include <Geode/loader/Dirs.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <chrono>
@@ -600,7 +601,10 @@ ServerRequest<ServerModsList> server::getMods(ModsQuery const& query, bool useCa
     req.param("page", std::to_string(query.page + 1));
     req.param("per_page", std::to_string(query.pageSize));
 
-    return req.get(formatServerURL("/mods")).map(
+    return req.get(formatServerURL("/mods")).mapOn(
+        // Parse the response on the request thread instead of the main thread,
+        // since these payloads can be large
+        TaskExecutor::Background,
         [](web::WebResponse* response) -> Result<ServerModsList, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -633,7 +637,8 @@ ServerRequest<ServerModMetadata> server::getMod(std::string const& id, bool useC
     }
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
-    return req.get(formatServerURL("/mods/{}", id)).map(
+    return req.get(formatServerURL("/mods/{}", id)).mapOn(
+        TaskExecutor::Background,
         [](web::WebResponse* response) -> Result<ServerModMetadata, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -688,7 +693,8 @@ ServerRequest<ServerModVersion> server::getModVersion(std::string const& id, Mod
         },
     }, version);
 
-    return req.get(formatServerURL("/mods/{}/versions/{}", id, versionURL)).map(
+    return req.get(formatServerURL("/mods/{}/versions/{}", id, versionURL)).mapOn(
+        TaskExecutor::Background,
         [](web::WebResponse* response) -> Result<ServerModVersion, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -711,18 +717,88 @@ ServerRequest<ServerModVersion> server::getModVersion(std::string const& id, Mod
     );
 }
 
-ServerRequest<ByteVector> server::getModLogo(std::string const& id, bool useCache) {
+static std::filesystem::path getModLogoCachePath(std::string const& id, VersionInfo const& version) {
+    return dirs::getIndexDir() / "logos" / fmt::format("{}@{}.png", id, version.toNonVString());
+}
+
+// Logos of mod versions that haven't been looked at in a while get removed 
+// once the cache grows past this many
+static constexpr size_t MAX_CACHED_MOD_LOGOS = 500;
+
+static void pruneModLogoCache() {
+    std::error_code ec;
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> logos;
+    for (auto const& entry : std::filesystem::directory_iterator(dirs::getIndexDir() / "logos", ec)) {
+        logos.push_back({ entry.last_write_time(ec), entry.path() });
+    }
+    if (logos.size() <= MAX_CACHED_MOD_LOGOS) {
+        return;
+    }
+    std::sort(logos.begin(), logos.end());
+    for (size_t i = 0; i < logos.size() - MAX_CACHED_MOD_LOGOS; i += 1) {
+        std::filesystem::remove(logos[i].second, ec);
+    }
+}
+
+static Result<Ref<CCImage>, ServerError> decodeModLogo(ByteVector const& data) {
+    auto image = new CCImage();
+    auto ref = Ref(image);
+    image->release();
+    if (!image->initWithImageData(const_cast<uint8_t*>(data.data()), data.size())) {
+        return Err(ServerError(0, "Unable to decode logo"));
+    }
+    return Ok(ref);
+}
+
+ServerRequest<ByteVector> server::getModLogoData(std::string const& id, std::optional<VersionInfo> const& version, bool useCache) {
     if (useCache) {
-        return getCache<getModLogo>().get(id);
+        return getCache<getModLogoData>().get(id, version);
+    }
+
+    // Logos are immutable per mod version, so if this one has been 
+    // downloaded before it can just be read from disk
+    if (version) {
+        auto path = getModLogoCachePath(id, *version);
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec)) {
+            return ServerRequest<ByteVector>::run(
+                [path](auto, auto) -> ServerRequest<ByteVector>::Result {
+                    Result<ByteVector, ServerError> res = Err(ServerError(0, "Unable to read cached logo"));
+                    if (auto data = file::readBinary(path)) {
+                        res = Ok(std::move(data).unwrap());
+                        // Mark the logo as recently used so pruning keeps it
+                        std::error_code ec;
+                        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+                    }
+                    return std::move(res);
+                },
+                fmt::format("Cached logo for {}", id)
+            );
+        }
     }
+
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
-    return req.get(formatServerURL("/mods/{}/logo", id)).map(
-        [](web::WebResponse* response) -> Result<ByteVector, ServerError> {
-            if (response->ok()) {
-                return Ok(response->data());
+    // The request's own thread handles saving the logo, and cancelling the 
+    // mapped task cancels the request
+    return req.get(formatServerURL("/mods/{}/logo", id)).mapOn(
+        TaskExecutor::Background,
+        [id, version](web::WebResponse* response) -> Result<ByteVector, ServerError> {
+            if (!response->ok()) {
+                return Err(parseServerError(*response));
             }
-            return Err(parseServerError(*response));
+            auto data = response->data();
+            if (version) {
+                static std::once_flag pruned;
+                std::call_once(pruned, &pruneModLogoCache);
+
+                auto path = getModLogoCachePath(id, *version);
+                (void)file::createDirectoryAll(path.parent_path());
+                if (auto res = file::writeBinary(path, data); !res) {
+                    log::warn("Unable to cache logo for {}: {}", id, res.unwrapErr());
+                }
+            }
+            return Ok(std::move(data));
         },
         [id](web::WebProgress* progress) {
             return parseServerProgress(*progress, "Downloading logo for " + id);
@@ -730,13 +806,54 @@ ServerRequest<ByteVector> server::getModLogo(std::string const& id, bool useCach
     );
 }
 
+ServerRequest<Ref<CCImage>> server::getModLogo(std::string const& id, std::optional<VersionInfo> const& version, bool useCache) {
+    auto data = getModLogoData(id, version, useCache);
+    auto name = fmt::format("Logo for {}", id);
+    auto decode = [id, version](Result<ByteVector, ServerError> const& data) -> Result<Ref<CCImage>, ServerError> {
+        if (!data) {
+            return Err(data.unwrapErr());
+        }
+        auto image = decodeModLogo(data.unwrap());
+        // Don't keep loading a broken file from the disk cache
+        if (!image && version) {
+            std::error_code ec;
+            std::filesystem::remove(getModLogoCachePath(id, *version), ec);
+        }
+        return image;
+    };
+
+    // Logos from the cache have already been fetched, so mapping them would 
+    // decode them right here on the main thread
+    if (auto finished = data.getFinishedValue()) {
+        return ServerRequest<Ref<CCImage>>::run(
+            [decode, data = *finished](auto, auto) -> ServerRequest<Ref<CCImage>>::Result {
+                auto res = decode(data);
+                return std::move(res);
+            },
+            name
+        );
+    }
+    // Otherwise decode on whichever thread finishes fetching the logo
+    return data.mapOn(
+        TaskExecutor::Background,
+        [decode](Result<ByteVector, ServerError>* data) {
+            return decode(*data);
+        },
+        [](ServerProgress* progress) {
+            return *progress;
+        },
+        name
+    );
+}
+
 ServerRequest<std::unordered_set<std::string>> server::getTags(bool useCache) {
     if (useCache) {
         return getCache<getTags>().get();
     }
     auto req = web::WebRequest();
     req.userAgent(getServerUserAgent());
-    return req.get(formatServerURL("/tags")).map(
+    return req.get(formatServerURL("/tags")).mapOn(
+        TaskExecutor::Background,
         [](web::WebResponse* response) -> Result<std::unordered_set<std::string>, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -793,7 +910,8 @@ ServerRequest<std::vector<ServerModUpdate>> server::batchedCheckUpdates(std::vec
     req.param("geode", Loader::get()->getVersion().toNonVString());
 
     req.param("ids", ranges::join(batch, ";"));
-    return req.get(formatServerURL("/mods/updates")).map(
+    return req.get(formatServerURL("/mods/updates")).mapOn(
+        TaskExecutor::Background,
         [](web::WebResponse* response) -> Result<std::vector<ServerModUpdate>, ServerError> {
             if (response->ok()) {
                 // Parse payload
@@ -892,7 +1010,7 @@ ServerRequest<std::vector<ServerModUpdate>> server::checkAllUpdates(bool useCach
 void server::clearServerCaches(bool clearGlobalCaches) {
     getCache<&getMods>().clear();
     getCache<&getMod>().clear();
-    getCache<&getModLogo>().clear();
+    getCache<&getModLogoData>().clear();
 
     // Only clear global caches if explicitly requested
     if (clearGlobalCaches) {
@@ -905,7 +1023,7 @@ $on_mod(Loaded) {
     listenForSettingChanges<int64_t>("server-cache-size-limit", +[](int64_t size) {
         getCache<&server::getMods>().limit(size);
         getCache<&server::getMod>().limit(size);
-        getCache<&server::getModLogo>().limit(size);
+        getCache<&server::getModLogoData>().limit(size);
         getCache<&server::getTags>().limit(size);
         getCache<&server::checkAllUpdates>().limit(size);
     });
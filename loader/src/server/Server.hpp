@@ -2,6 +2,7 @@
 
 #include "Geode/utils/VersionInfo.hpp"
 #include <Geode/DefaultInclude.hpp>
+#include <Geode/utils/cocos.hpp>
 #include <Geode/utils/web.hpp>
 #include <Geode/loader/SettingEvent.hpp>
 #include <chrono>
@@ -147,7 +148,25 @@ namespace server {
     ServerRequest<ServerModsList> getMods(ModsQuery const& query, bool useCache = true);
     ServerRequest<ServerModMetadata> getMod(std::string const& id, bool useCache = true);
     ServerRequest<ServerModVersion> getModVersion(std::string const& id, ModVersion const& version = ModVersionLatest(), bool useCache = true);
-    ServerRequest<ByteVector> getModLogo(std::string const& id, bool useCache = true);
+    /**
+     * Fetch the encoded logo of a mod. If a version is provided, the logo is 
+     * also cached on disk for that version of the mod
+     */
+    ServerRequest<ByteVector> getModLogoData(
+        std::string const& id,
+        std::optional<VersionInfo> const& version = std::nullopt,
+        bool useCache = true
+    );
+    /**
+     * Fetch the logo of a mod. The logo is decoded off the main thread, so 
+     * only the texture upload is left for the caller. Only the encoded logo 
+     * is kept in the cache; see `getModLogoData`
+     */
+    ServerRequest<Ref<CCImage>> getModLogo(
+        std::string const& id,
+        std::optional<VersionInfo> const& version = std::nullopt,
+        bool useCache = true
+    );
     ServerRequest<std::unordered_set<std::string>> getTags(bool useCache = true);
 
     ServerRequest<std::optional<ServerModUpdate>> checkUpdates(Mod const* mod);
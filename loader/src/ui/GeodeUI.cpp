@@ -173,10 +173,11 @@ Popup<Mod*>* geode::openSettingsPopup(Mod* mod, bool disableGeodeTheme) {
 class ModLogoSprite : public CCNode {
 protected:
     std::string m_modID;
+    std::string m_textureKey;
     CCNode* m_sprite = nullptr;
-    EventListener<server::ServerRequest<ByteVector>> m_listener;
+    EventListener<server::ServerRequest<Ref<CCImage>>> m_listener;
 
-    bool init(std::string const& id, bool fetch) {
+    bool init(std::string const& id, bool fetch, std::optional<VersionInfo> const& version = std::nullopt) {
         if (!CCNode::init())
             return false;
         
@@ -187,6 +188,7 @@ protected:
         this->setID(std::string(Mod::get()->expandSpriteName(fmt::format("sprite-{}", id))));
 
         m_modID = id;
+        m_textureKey = version ? fmt::format("{}@{}", id, version->toNonVString()) : id;
         m_listener.bind(this, &ModLogoSprite::onFetch);
 
         // Load from Resources
@@ -197,10 +199,14 @@ protected:
                 false
             );
         }
+        // If this logo has already been uploaded this session, reuse it
+        else if (auto texture = CCTextureCache::get()->textureForKey(m_textureKey.c_str())) {
+            this->setSprite(CCSprite::createWithTexture(texture), false);
+        }
         // Asynchronously fetch from server
         else {
             this->setSprite(createLoadingCircle(25), false);
-            m_listener.setFilter(server::getModLogo(id));
+            m_listener.setFilter(server::getModLogo(id, version));
         }
 
         ModLogoUIEvent(std::make_unique<ModLogoUIEvent::Impl>(this, id)).post();
@@ -229,19 +235,15 @@ protected:
         }
     }
 
-    void onFetch(server::ServerRequest<ByteVector>::Event* event) {
+    void onFetch(server::ServerRequest<Ref<CCImage>>::Event* event) {
         if (auto result = event->getValue()) {
             // Set default sprite on error
             if (result->isErr()) {
                 this->setSprite(nullptr, true);
             }
-            // Otherwise load downloaded sprite to memory
+            // Otherwise upload the already decoded image
             else {
-                auto data = result->unwrap();
-                auto image = Ref(new CCImage());
-                image->initWithImageData(data.data(), data.size());
-
-                auto texture = CCTextureCache::get()->addUIImage(image, m_modID.c_str());
+                auto texture = CCTextureCache::get()->addUIImage(result->unwrap(), m_textureKey.c_str());
                 this->setSprite(CCSprite::createWithTexture(texture), true);
             }
         }
@@ -251,9 +253,9 @@ protected:
     }
 
 public:
-    static ModLogoSprite* create(std::string const& id, bool fetch = false) {
+    static ModLogoSprite* create(std::string const& id, bool fetch = false, std::optional<VersionInfo> const& version = std::nullopt) {
         auto ret = new ModLogoSprite();
-        if (ret->init(id, fetch)) {
+        if (ret->init(id, fetch, version)) {
             ret->autorelease();
             return ret;
         }
@@ -273,3 +275,7 @@ CCNode* geode::createModLogo(Mod* mod) {
 CCNode* geode::createServerModLogo(std::string const& id) {
     return ModLogoSprite::create(id, true);
 }
+
+CCNode* geode::createServerModLogo(std::string const& id, VersionInfo const& version) {
+    return ModLogoSprite::create(id, true, version);
+}
@@ -36,31 +36,37 @@ $on_mod(Loaded) {
     ColorProvider::get()->define("mods-layer-gd-bg"_spr, { 0, 102, 255, 255 });
 
     auto updateColors = +[](bool enabled) {
+        // Apply all of the colors at once so listeners get notified in a 
+        // single event instead of one per color
         if (enabled) {
-            ColorProvider::get()->reset("mod-list-bg"_spr);
-            ColorProvider::get()->reset("mod-list-version-bg-updates-available"_spr);
-            ColorProvider::get()->reset("mod-list-search-bg"_spr);
-            ColorProvider::get()->reset("mod-list-tab-deselected-bg"_spr);
-            ColorProvider::get()->reset("mod-list-tab-selected-bg"_spr);
-            ColorProvider::get()->reset("mod-list-tab-selected-bg-alt"_spr);
-            ColorProvider::get()->reset("mod-list-restart-required-label"_spr);
-            ColorProvider::get()->reset("mod-list-restart-required-label-bg"_spr);
-            ColorProvider::get()->reset("mod-problems-item-bg"_spr);
-            ColorProvider::get()->reset("mod-developer-item-bg"_spr);
+            ColorProvider::get()->applyTheme({
+                { "mod-list-bg"_spr, std::nullopt },
+                { "mod-list-version-bg-updates-available"_spr, std::nullopt },
+                { "mod-list-search-bg"_spr, std::nullopt },
+                { "mod-list-tab-deselected-bg"_spr, std::nullopt },
+                { "mod-list-tab-selected-bg"_spr, std::nullopt },
+                { "mod-list-tab-selected-bg-alt"_spr, std::nullopt },
+                { "mod-list-restart-required-label"_spr, std::nullopt },
+                { "mod-list-restart-required-label-bg"_spr, std::nullopt },
+                { "mod-problems-item-bg"_spr, std::nullopt },
+                { "mod-developer-item-bg"_spr, std::nullopt },
+            });
         }
         else {
-            ColorProvider::get()->override("mod-list-bg"_spr, { 168, 85, 44, 255 });
-            ColorProvider::get()->override("mod-list-version-bg-updates-available"_spr, { 220, 190, 0, 120 });
-            ColorProvider::get()->override("mod-list-search-bg"_spr, { 114, 63, 31, 255 });
-            ColorProvider::get()->override("mod-list-tab-deselected-bg"_spr, { 54, 31, 16, 255 });
-            ColorProvider::get()->override("mod-list-tab-selected-bg"_spr, { 248, 200, 43, 255 });
-            ColorProvider::get()->override("mod-list-tab-selected-bg-alt"_spr, { 156, 185, 147, 255 });
-            ColorProvider::get()->override("mod-list-restart-required-label"_spr, ccc3(10, 226, 255));
-            ColorProvider::get()->override("mod-list-restart-required-label-bg"_spr, ccc3(0, 174, 180));
-            ColorProvider::get()->override("mod-list-errors-found"_spr, { 255, 0, 0, 255 });
-            ColorProvider::get()->override("mod-list-errors-found-2"_spr, { 235, 35, 112, 255 });
-            ColorProvider::get()->override("mod-problems-item-bg"_spr, { 0, 0, 0, 75 });
-            ColorProvider::get()->override("mod-developer-item-bg"_spr, { 0, 0, 0, 75 });
+            ColorProvider::get()->applyTheme({
+                { "mod-list-bg"_spr, ccc4(168, 85, 44, 255) },
+                { "mod-list-version-bg-updates-available"_spr, ccc4(220, 190, 0, 120) },
+                { "mod-list-search-bg"_spr, ccc4(114, 63, 31, 255) },
+                { "mod-list-tab-deselected-bg"_spr, ccc4(54, 31, 16, 255) },
+                { "mod-list-tab-selected-bg"_spr, ccc4(248, 200, 43, 255) },
+                { "mod-list-tab-selected-bg-alt"_spr, ccc4(156, 185, 147, 255) },
+                { "mod-list-restart-required-label"_spr, to4B(ccc3(10, 226, 255)) },
+                { "mod-list-restart-required-label-bg"_spr, to4B(ccc3(0, 174, 180)) },
+                { "mod-list-errors-found"_spr, ccc4(255, 0, 0, 255) },
+                { "mod-list-errors-found-2"_spr, ccc4(235, 35, 112, 255) },
+                { "mod-problems-item-bg"_spr, ccc4(0, 0, 0, 75) },
+                { "mod-developer-item-bg"_spr, ccc4(0, 0, 0, 75) },
+            });
         }
     };
 
@@ -11,20 +11,22 @@
 // needed for weightedFuzzyMatch
 #include <ui/mods/sources/ModListSource.hpp>
 
-static bool matchSearch(SettingNodeV3* node, std::string const& query) {
+static bool matchSearch(
+    SettingNodeV3* node, std::string const& key, std::optional<std::string> const& name,
+    std::string const& query
+) {
     if (typeinfo_cast<TitleSettingNodeV3*>(node)) {
         return true;
     }
     bool addToList = false;
-    auto setting = node->getSetting();
     double weighted = 0;
-    if (auto name = setting->getName()) {
-        addToList |= weightedFuzzyMatch(setting->getKey(), query, 0.5, weighted);
+    if (name) {
+        addToList |= weightedFuzzyMatch(key, query, 0.5, weighted);
         addToList |= weightedFuzzyMatch(*name, query, 1, weighted);
     }
     // If there's no name, give full weight to key
     else {
-        addToList |= weightedFuzzyMatch(setting->getKey(), query, 1, weighted);
+        addToList |= weightedFuzzyMatch(key, query, 1, weighted);
     }
     if (weighted < 60 + 10 * query.size()) {
         addToList = false;
@@ -54,8 +56,9 @@ bool ModSettingsPopup::setup(Mod* mod) {
     m_searchInput->setTextAlign(TextInputAlign::Left);
     m_searchInput->setScale(.7f);
     m_searchInput->setCallback([this](auto const&) {
-        this->updateState();
+        this->updateFilter();
         m_list->moveToTop();
+        this->updateVisibleSettings();
     });
     m_searchInput->setID("search-input");
     searchContainer->addChildAtPosition(m_searchInput, Anchor::Left, ccp(7.5f, 0), ccp(0, .5f));
@@ -73,26 +76,35 @@ bool ModSettingsPopup::setup(Mod* mod) {
     m_list = ScrollLayer::create(layerSize - ccp(0, searchContainer->getContentHeight()));
     m_list->setTouchEnabled(true);
 
+    // The list is laid out manually in layoutSettings rather than through a 
+    // ColumnLayout, since it's just a single column of full-width nodes and 
+    // hidden settings stay in the list as invisible nodes
+    TitleSettingNodeV3* lastTitle = nullptr;
     for (auto& key : mod->getSettingKeys()) {
         SettingNodeV3* node;
+        SettingEntry entry;
+        entry.key = key;
         if (auto sett = mod->getSettingV3(key)) {
             node = sett->createNode(layerSize.width);
+            entry.name = sett->getName();
+            for (auto& dep : sett->getEnableIfDependencies()) {
+                m_dependents[dep].push_back(node);
+            }
         }
         else {
             node = UnresolvedCustomSettingNodeV3::create(key, mod, layerSize.width);
         }
+        if (auto asTitle = typeinfo_cast<TitleSettingNodeV3*>(node)) {
+            lastTitle = asTitle;
+        }
+        else {
+            entry.title = lastTitle;
+        }
 
         m_settings.push_back(node);
+        m_entries.push_back(std::move(entry));
         m_list->m_contentLayer->addChild(node);
     }
-    m_list->m_contentLayer->setLayout(
-        ColumnLayout::create()
-            ->setAxisReverse(true)
-            ->setAutoGrowAxis(m_list->getContentHeight())
-            ->setCrossAxisOverflow(false)
-            ->setAxisAlignment(AxisAlignment::End)
-            ->setGap(0)
-    );
     m_list->moveToTop();
 
     const int buttonPriority = m_list->getTouchPriority() - 1;
@@ -188,6 +200,7 @@ bool ModSettingsPopup::setup(Mod* mod) {
         this->updateState(ev->getNode());
         return ListenerResult::Propagate;
     });
+    this->scheduleUpdate();
     this->updateState();
 
     return true;
@@ -246,54 +259,53 @@ void ModSettingsPopup::onOpenPersistentDirectory(CCObject*) {
 }
 void ModSettingsPopup::onClearSearch(CCObject*) {
     m_searchInput->setString("");
-    this->updateState();
+    this->updateFilter();
     m_list->moveToTop();
+    this->updateVisibleSettings();
 }
 
 void ModSettingsPopup::updateState(SettingNodeV3* invoker) {
-    auto search = m_searchInput->getString();
-    auto hasSearch = !search.empty();
-
     m_restartBtn->setVisible(ModSettingsManager::from(m_mod)->restartRequired());
     m_applyMenu->updateLayout();
 
-    auto listPosBefore = m_list->m_contentLayer->getPositionY();
-    auto listHeightBefore = m_list->m_contentLayer->getContentHeight();
-
-    // Update search visibility + all settings with "enable-if" schemes + 
-    // checkerboard BG
-    TitleSettingNodeV3* lastTitle = nullptr;
-    bool bg = false;
-    for (auto& sett : m_settings) {
-        if (auto asTitle = typeinfo_cast<TitleSettingNodeV3*>(sett.data())) {
-            lastTitle = asTitle;
-        }
-        sett->removeFromParent();
-        if (
-            // Show if the setting is not a title and is not subject to a collapsed title
-            !(lastTitle && lastTitle != sett && lastTitle->isCollapsed()) &&
-            // Show if there's no search query or if the setting matches it
-            (!hasSearch || matchSearch(sett, search))
-        ) {
-            m_list->m_contentLayer->addChild(sett);
-            sett->setDefaultBGColor(ccc4(0, 0, 0, bg ? 60 : 20));
-            bg = !bg;
+    // Collapsing a title changes which settings are shown
+    if (typeinfo_cast<TitleSettingNodeV3*>(invoker)) {
+        this->updateFilter();
+    }
+    else if (invoker) {
+        // Only settings whose "enable-if" depends on the changed setting can 
+        // have been affected by the change
+        if (auto setting = invoker->getSetting()) {
+            auto deps = m_dependents.find(setting->getKey());
+            if (deps != m_dependents.end()) {
+                for (auto sett : deps->second) {
+                    // Avoid infinite loops
+                    if (sett != invoker) {
+                        sett->updateState(nullptr);
+                    }
+                }
+            }
         }
-        // Avoid infinite loops
-        if (sett == invoker) {
-            continue;
+        // Some settings change their size when edited
+        auto it = std::find_if(m_settings.begin(), m_settings.end(), [invoker](auto const& sett) {
+            return sett.data() == invoker;
+        });
+        if (it != m_settings.end()) {
+            auto& entry = m_entries.at(it - m_settings.begin());
+            if (entry.shown && entry.height != invoker->getScaledContentHeight()) {
+                this->layoutSettings();
+            }
         }
-        if (sett->getSetting() && sett->getSetting()->getEnableIf()) {
-            sett->updateState(nullptr);
+    }
+    // Full refresh
+    else {
+        for (auto& sett : m_settings) {
+            if (sett->getSetting() && sett->getSetting()->getEnableIf()) {
+                sett->updateState(nullptr);
+            }
         }
+        this->updateFilter();
     }
-    m_list->m_contentLayer->updateLayout();
-
-    // Preserve relative list position if something has been collapsed
-    m_list->m_contentLayer->setPositionY(
-        listPosBefore + 
-            (listHeightBefore - m_list->m_contentLayer->getContentHeight())
-    );
 
     m_applyBtnSpr->setCascadeColorEnabled(true);
     m_applyBtnSpr->setCascadeOpacityEnabled(true);
@@ -307,7 +319,34 @@ void ModSettingsPopup::updateState(SettingNodeV3* invoker) {
         m_applyBtnSpr->setOpacity(155);
         m_applyBtn->setEnabled(false);
     }
-    
+}
+
+void ModSettingsPopup::updateFilter() {
+    auto search = m_searchInput->getString();
+    auto hasSearch = !search.empty();
+
+    // Update search visibility + checkerboard BG
+    bool bg = false;
+    for (size_t i = 0; i < m_settings.size(); i += 1) {
+        auto& sett = m_settings[i];
+        auto& entry = m_entries[i];
+        entry.shown =
+            // Show if the setting is not subject to a collapsed title
+            !(entry.title && entry.title->isCollapsed()) &&
+            // Show if there's no search query or if the setting matches it
+            (!hasSearch || matchSearch(sett, entry.key, entry.name, search));
+        if (entry.shown) {
+            // Changing the BG color updates the node's state, so only do it 
+            // when the color actually changes
+            if (entry.bg != bg) {
+                entry.bg = bg;
+                sett->setDefaultBGColor(ccc4(0, 0, 0, bg ? 60 : 20));
+            }
+            bg = !bg;
+        }
+    }
+    this->layoutSettings();
+
     auto clearSpr = static_cast<GeodeSquareSprite*>(m_searchClearBtn->getNormalImage());
     m_searchClearBtn->setEnabled(hasSearch);
     clearSpr->setColor(hasSearch ? ccWHITE : ccGRAY);
@@ -316,6 +355,75 @@ void ModSettingsPopup::updateState(SettingNodeV3* invoker) {
     clearSpr->getTopSprite()->setOpacity(hasSearch ? 255 : 90);
 }
 
+void ModSettingsPopup::layoutSettings() {
+    auto content = m_list->m_contentLayer;
+    auto listPosBefore = content->getPositionY();
+    auto listHeightBefore = content->getContentHeight();
+
+    float totalHeight = 0;
+    for (size_t i = 0; i < m_settings.size(); i += 1) {
+        auto& entry = m_entries[i];
+        entry.height = m_settings[i]->getScaledContentHeight();
+        if (entry.shown) {
+            totalHeight += entry.height;
+        }
+    }
+    content->setContentHeight(std::max(totalHeight, m_list->getContentHeight()));
+
+    // Stack shown settings from the top down
+    float y = content->getContentHeight();
+    for (size_t i = 0; i < m_settings.size(); i += 1) {
+        auto& sett = m_settings[i];
+        auto& entry = m_entries[i];
+        if (!entry.shown) {
+            continue;
+        }
+        y -= entry.height;
+        entry.posY = y;
+        auto anchor = sett->isIgnoreAnchorPointForPosition() ? CCPointZero : sett->getAnchorPoint();
+        sett->setPosition(
+            content->getContentWidth() / 2 + sett->getScaledContentWidth() * (anchor.x - .5f),
+            y + entry.height * anchor.y
+        );
+    }
+
+    // Preserve relative list position if something has been collapsed
+    content->setPositionY(
+        listPosBefore + 
+            (listHeightBefore - content->getContentHeight())
+    );
+    this->updateVisibleSettings();
+}
+
+void ModSettingsPopup::updateVisibleSettings() {
+    // Only settings that are actually in view are kept in the list, so 
+    // settings that are scrolled out of view or filtered out aren't drawn 
+    // and their menus and inputs can't be touched. m_settings keeps the 
+    // detached nodes alive
+    auto content = m_list->m_contentLayer;
+    m_lastListPosY = content->getPositionY();
+    auto viewHeight = m_list->getContentHeight();
+    for (size_t i = 0; i < m_settings.size(); i += 1) {
+        auto& sett = m_settings[i];
+        auto& entry = m_entries[i];
+        auto bottom = m_lastListPosY + entry.posY;
+        auto inView = entry.shown && bottom + entry.height >= 0 && bottom <= viewHeight;
+        if (inView && !sett->getParent()) {
+            content->addChild(sett);
+        }
+        else if (!inView && sett->getParent()) {
+            sett->removeFromParentAndCleanup(false);
+        }
+    }
+}
+
+void ModSettingsPopup::update(float dt) {
+    GeodePopup::update(dt);
+    if (m_list->m_contentLayer->getPositionY() != m_lastListPosY) {
+        this->updateVisibleSettings();
+    }
+}
+
 bool ModSettingsPopup::hasUncommitted() const {
     for (auto& sett : m_settings) {
         if (sett->hasUncommittedChanges()) {
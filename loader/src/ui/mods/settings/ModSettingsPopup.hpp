@@ -10,11 +10,31 @@
 
 using namespace geode::prelude;
 
+class TitleSettingNodeV3;
+
 class ModSettingsPopup : public GeodePopup<Mod*> {
 protected:
+    struct SettingEntry final {
+        // Precomputed so searching doesn't have to copy these out of the 
+        // setting on every keystroke
+        std::string key;
+        std::optional<std::string> name;
+        // The title whose section this setting is in, if any
+        TitleSettingNodeV3* title = nullptr;
+        bool shown = true;
+        std::optional<bool> bg;
+        float posY = 0;
+        float height = 0;
+    };
+
     Mod* m_mod;
     ScrollLayer* m_list;
     std::vector<Ref<SettingNodeV3>> m_settings;
+    // Same order as m_settings
+    std::vector<SettingEntry> m_entries;
+    // Settings whose "enable-if" depends on the setting with the given key
+    std::unordered_map<std::string, std::vector<SettingNodeV3*>> m_dependents;
+    float m_lastListPosY = 0;
     CCMenu* m_applyMenu;
     CCMenuItemSpriteExtra* m_applyBtn;
     CCMenuItemSpriteExtra* m_restartBtn;
@@ -25,6 +45,10 @@ protected:
 
     bool setup(Mod* mod) override;
     void updateState(SettingNodeV3* invoker = nullptr);
+    void updateFilter();
+    void layoutSettings();
+    void updateVisibleSettings();
+    void update(float dt) override;
     bool hasUncommitted() const;
     void onClose(CCObject*) override;
     void onApply(CCObject*);
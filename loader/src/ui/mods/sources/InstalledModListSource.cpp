@@ -17,13 +17,16 @@ bool InstalledModsQuery::preCheck(ModSource const& src) const {
     }
     return true;
 }
-bool InstalledModsQuery::queryCheck(ModSource const& src, double& weighted) const {
+bool InstalledModsQuery::queryCheck(
+    ModSource const& src, ModSearchIndex::Entry const& entry,
+    std::optional<ModSearchIndex::Query> const& search, double& weighted
+) const {
     bool addToList = true;
     if (enabledOnly) {
         addToList = src.asMod()->isEnabled() == *enabledOnly;
     }
-    if (query) {
-        addToList = modFuzzyMatch(src.asMod()->getMetadata(), *query, weighted);
+    if (search) {
+        addToList = modFuzzyMatch(entry, *search, weighted);
     }
     // Loader gets boost to ensure it's normally always top of the list
     if (addToList && src.asMod()->isInternal()) {
@@ -85,10 +88,10 @@ InstalledModListSource::ProviderTask InstalledModListSource::fetchPage(size_t pa
             tasks.push_back(src.checkUpdates());
         }
         return UpdateTask::all(std::move(tasks)).map(
-            [content = std::move(content), query = m_query](auto*) mutable -> ProviderTask::Value {
+            [this, content = std::move(content), query = m_query](auto*) mutable -> ProviderTask::Value {
                 // Filter the results based on the current search 
                 // query and return them
-                filterModsWithLocalQuery(content, query);
+                filterModsWithLocalQuery(content, query, m_index);
                 return Ok(content);
             },
             [](auto*) -> ProviderTask::Progress { return std::nullopt; }
@@ -96,7 +99,7 @@ InstalledModListSource::ProviderTask InstalledModListSource::fetchPage(size_t pa
     }
     // Otherwise simply construct the result right away
     else {
-        filterModsWithLocalQuery(content, m_query);
+        filterModsWithLocalQuery(content, m_query, m_index);
         return ProviderTask::immediate(Ok(content));
     }
 }
@@ -2,9 +2,6 @@
 #include <server/DownloadManager.hpp>
 #include <Geode/loader/ModSettingsManager.hpp>
 
-#define FTS_FUZZY_MATCH_IMPLEMENTATION
-#include <Geode/external/fts/fts_fuzzy_match.h>
-
 static constexpr size_t PER_PAGE = 10;
 static std::vector<ModListSource*> ALL_EXTANT_SOURCES {};
 
@@ -101,29 +98,40 @@ bool ModListSource::isRestartRequired() {
     return false;
 }
 
-bool weightedFuzzyMatch(std::string const& str, std::string const& kw, double weight, double& out) {
-    int score;
-    if (fts::fuzzy_match(kw.c_str(), str.c_str(), score)) {
-        out = std::max(out, score * weight);
-        return true;
-    }
-    return false;
-}
-bool modFuzzyMatch(ModMetadata const& metadata, std::string const& kw, double& weighted) {
-    bool addToList = false;
-    addToList |= weightedFuzzyMatch(metadata.getName(), kw, 1, weighted);
-    addToList |= weightedFuzzyMatch(metadata.getID(), kw, 0.5, weighted);
-    for (auto& dev : metadata.getDevelopers()) {
-        addToList |= weightedFuzzyMatch(dev, kw, 0.25, weighted);
-    }
-    if (auto details = metadata.getDetails()) {
-        addToList |= weightedFuzzyMatch(*details, kw, 0.005, weighted);
-    }
-    if (auto desc = metadata.getDescription()) {
-        addToList |= weightedFuzzyMatch(*desc, kw, 0.02, weighted);
+void ModSearchIndex::update(std::vector<ModSource> const& mods, bool withDetails) {
+    // Drop mods that have since been removed from the list
+    if (m_entries.size() > mods.size()) {
+        std::unordered_set<Mod*> current;
+        for (auto& src : mods) {
+            current.insert(src.asMod());
+        }
+        std::erase_if(m_entries, [&](auto const& entry) {
+            return !current.contains(entry.first);
+        });
     }
-    if (weighted < 2) {
-        addToList = false;
+    for (auto& src : mods) {
+        auto mod = src.asMod();
+        auto it = m_entries.find(mod);
+        if (it == m_entries.end()) {
+            auto entry = Entry {
+                .name = mod->getName(),
+                .tags = mod->getMetadata().getTags(),
+            };
+            addField(entry, entry.name, 1);
+            addField(entry, mod->getID(), 0.5);
+            for (auto& dev : mod->getDevelopers()) {
+                addField(entry, dev, 0.25);
+            }
+            if (auto desc = mod->getDescription()) {
+                addField(entry, *desc, 0.02);
+            }
+            it = m_entries.emplace(mod, std::move(entry)).first;
+        }
+        if (withDetails && !it->second.hasDetails) {
+            if (auto details = mod->getDetails()) {
+                addField(it->second, *details, 0.005);
+            }
+            it->second.hasDetails = true;
+        }
     }
-    return addToList;
 }
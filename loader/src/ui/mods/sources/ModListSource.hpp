@@ -4,6 +4,7 @@
 #include <Geode/utils/string.hpp>
 #include <server/Server.hpp>
 #include "../list/ModItem.hpp"
+#include "ModSearchIndex.hpp"
 
 using namespace geode::prelude;
 
@@ -113,7 +114,10 @@ struct InstalledModsQuery final : public LocalModsQueryBase {
     InstalledModListType type = InstalledModListType::All;
     std::optional<bool> enabledOnly;
     bool preCheck(ModSource const& src) const;
-    bool queryCheck(ModSource const& src, double& weighted) const;
+    bool queryCheck(
+        ModSource const& src, ModSearchIndex::Entry const& entry,
+        std::optional<ModSearchIndex::Query> const& search, double& weighted
+    ) const;
     bool isDefault() const;
 };
 
@@ -121,6 +125,7 @@ class InstalledModListSource : public ModListSource {
 protected:
     InstalledModListType m_type;
     InstalledModsQuery m_query;
+    ModSearchIndex m_index;
 
     void resetQuery() override;
     ProviderTask fetchPage(size_t page, size_t pageSize, bool forceUpdate) override;
@@ -187,16 +192,21 @@ public:
     bool isDefaultQuery() const override;
 };
 
-bool weightedFuzzyMatch(std::string const& str, std::string const& kw, double weight, double& out);
-bool modFuzzyMatch(ModMetadata const& metadata, std::string const& kw, double& out);
-
 template <std::derived_from<LocalModsQueryBase> Query>
-void filterModsWithLocalQuery(ModListSource::ProvidedMods& mods, Query const& query) {
-    std::vector<std::pair<ModSource, double>> filtered;
+void filterModsWithLocalQuery(ModListSource::ProvidedMods& mods, Query const& query, ModSearchIndex& index) {
+    struct Scored final {
+        ModSource* src;
+        ModSearchIndex::Entry const* entry;
+        double weighted;
+    };
+    std::vector<Scored> filtered;
+
+    auto search = query.query ? std::optional(ModSearchIndex::createQuery(*query.query)) : std::nullopt;
+    index.update(mods.mods, search.has_value());
 
     // Filter installed mods based on query
-    // TODO: maybe skip fuzzy matching altogether if query is empty?
     for (auto& src : mods.mods) {
+        auto& entry = index.get(src.asMod());
         double weighted = 0;
         bool addToList = true;
         // Do any checks additional this query has to start off with
@@ -205,44 +215,43 @@ void filterModsWithLocalQuery(ModListSource::ProvidedMods& mods, Query const& qu
         }
         // If some tags are provided, only return mods that match
         if (addToList && query.tags.size()) {
-            auto compare = src.getMetadata().getTags();
             for (auto& tag : query.tags) {
-                if (!compare.contains(tag)) {
+                if (!entry.tags.contains(tag)) {
                     addToList = false;
                 }
             }
         }
         // Don't bother with unnecessary fuzzy match calculations if this mod isn't going to be added anyway
         if (addToList) {
-            addToList = query.queryCheck(src, weighted);
+            addToList = query.queryCheck(src, entry, search, weighted);
         }
         if (addToList) {
-            filtered.push_back({ src, weighted });
+            filtered.push_back({ &src, &entry, weighted });
         }
     }
 
     // Sort list based on score
-    std::sort(filtered.begin(), filtered.end(), [](auto a, auto b) {
+    std::sort(filtered.begin(), filtered.end(), [](Scored const& a, Scored const& b) {
         // Sort primarily by score
-        if (a.second != b.second) {
-            return a.second > b.second;
+        if (a.weighted != b.weighted) {
+            return a.weighted > b.weighted;
         }
         // Sort secondarily alphabetically
         return utils::string::caseInsensitiveCompare(
-            a.first.getMetadata().getName(),
-            b.first.getMetadata().getName()
+            a.entry->name, b.entry->name
         ) == std::strong_ordering::less;
     });
 
-    mods.mods.clear();
     // Pick out only the mods in the page and page size specified in the query
+    std::vector<ModSource> page;
     for (
         size_t i = query.page * query.pageSize;
         i < filtered.size() && i < (query.page + 1) * query.pageSize;
         i += 1
     ) {
-        mods.mods.push_back(filtered.at(i).first);
+        page.push_back(std::move(*filtered.at(i).src));
     }
-    
+
+    mods.mods = std::move(page);
     mods.totalModCount = filtered.size();
 }
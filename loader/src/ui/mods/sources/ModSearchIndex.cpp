@@ -0,0 +1,59 @@
+#include "ModSearchIndex.hpp"
+#include <algorithm>
+#include <cctype>
+
+#define FTS_FUZZY_MATCH_IMPLEMENTATION
+#include <Geode/external/fts/fts_fuzzy_match.h>
+
+bool weightedFuzzyMatch(std::string const& str, std::string const& kw, double weight, double& out) {
+    int score;
+    if (fts::fuzzy_match(kw.c_str(), str.c_str(), score)) {
+        out = std::max(out, score * weight);
+        return true;
+    }
+    return false;
+}
+bool modFuzzyMatch(ModSearchIndex::Entry const& entry, ModSearchIndex::Query const& search, double& weighted) {
+    // If some character of the query appears nowhere in the mod, none of 
+    // its fields can match
+    if ((entry.chars & search.chars) != search.chars) {
+        return false;
+    }
+    bool addToList = false;
+    for (auto& field : entry.fields) {
+        if ((field.chars & search.chars) == search.chars) {
+            addToList |= weightedFuzzyMatch(field.text, search.text, field.weight, weighted);
+        }
+    }
+    if (weighted < 2) {
+        addToList = false;
+    }
+    return addToList;
+}
+
+ModSearchIndex::CharSet ModSearchIndex::charsOf(std::string_view str) {
+    CharSet chars;
+    for (auto c : str) {
+        chars.set(static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+    return chars;
+}
+ModSearchIndex::Query ModSearchIndex::createQuery(std::string const& text) {
+    return Query {
+        .text = text,
+        .chars = charsOf(text),
+    };
+}
+
+void ModSearchIndex::addField(Entry& entry, std::string const& text, double weight) {
+    auto chars = charsOf(text);
+    entry.chars |= chars;
+    entry.fields.push_back(Field {
+        .text = text,
+        .chars = chars,
+        .weight = weight,
+    });
+}
+ModSearchIndex::Entry const& ModSearchIndex::get(geode::Mod* mod) const {
+    return m_entries.at(mod);
+}
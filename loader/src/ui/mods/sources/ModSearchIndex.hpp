@@ -0,0 +1,62 @@
+#pragma once
+
+#include <bitset>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace geode {
+    class Mod;
+}
+class ModSource;
+
+// Precomputed search data for installed mods, so that searching doesn't have 
+// to copy every mod's metadata and fuzzy match all of it on every keystroke. 
+// A mod's metadata can't change while the game is running, so entries only 
+// need to be built when the mod list itself changes
+class ModSearchIndex final {
+public:
+    // Set of the (lowercased) characters that appear in a string. Fuzzy 
+    // matching requires every character of the query to appear in the 
+    // matched string, so anything whose set doesn't cover the query's can be 
+    // skipped without scoring it
+    using CharSet = std::bitset<256>;
+
+    struct Field final {
+        std::string text;
+        CharSet chars;
+        double weight;
+    };
+    struct Entry final {
+        std::string name;
+        std::unordered_set<std::string> tags;
+        std::vector<Field> fields;
+        CharSet chars;
+        // Details may have to be read from the mod's package, so they're 
+        // only indexed once a search needs them
+        bool hasDetails = false;
+    };
+    struct Query final {
+        std::string text;
+        CharSet chars;
+    };
+
+private:
+    std::unordered_map<geode::Mod*, Entry> m_entries;
+
+public:
+    static CharSet charsOf(std::string_view str);
+    static Query createQuery(std::string const& text);
+    static void addField(Entry& entry, std::string const& text, double weight);
+
+    // Add entries for any mods not yet indexed and drop mods that are gone. 
+    // Details are only added if `withDetails` is set. Defined in 
+    // ModListSource.cpp, since this is the only part that needs the mods
+    void update(std::vector<ModSource> const& mods, bool withDetails);
+    Entry const& get(geode::Mod* mod) const;
+};
+
+bool weightedFuzzyMatch(std::string const& str, std::string const& kw, double weight, double& out);
+bool modFuzzyMatch(ModSearchIndex::Entry const& entry, ModSearchIndex::Query const& search, double& out);
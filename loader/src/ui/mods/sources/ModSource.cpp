@@ -92,7 +92,8 @@ CCNode* ModSource::createModLogo() const {
             return geode::createModLogo(mod);
         },
         [](server::ServerModMetadata const& metadata) {
-            return createServerModLogo(metadata.id);
+            // The server always serves the logo of the latest version
+            return createServerModLogo(metadata.id, metadata.versions.front().metadata.getVersion());
         },
         [](ModSuggestion const& suggestion) {
             return createServerModLogo(suggestion.suggestion.getID());
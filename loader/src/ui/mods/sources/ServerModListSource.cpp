@@ -7,7 +7,8 @@ void ServerModListSource::resetQuery() {
 ServerModListSource::ProviderTask ServerModListSource::fetchPage(size_t page, size_t pageSize, bool forceUpdate) {
     m_query.page = page;
     m_query.pageSize = pageSize;
-    return server::getMods(m_query, !forceUpdate).map(
+    return server::getMods(m_query, !forceUpdate).mapOn(
+        TaskExecutor::Background,
         [](Result<server::ServerModsList, server::ServerError>* result) -> ProviderTask::Value {
             if (result->isOk()) {
                 auto list = result->unwrap();
@@ -377,15 +377,18 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
     if (!createLabel()) return {};
 
     bool firstLine = true;
-    for (auto line : utils::string::split(str, "\n")) {
+    for (auto line : utils::string::splitView(str, "\n")) {
         if (!firstLine && !nextLine()) {
             return {};
         }
         firstLine = false;
-        for (auto word : utils::string::split(line, " ")) {
+        for (auto wordView : utils::string::splitView(line, " ")) {
             // add extra space in front of word if not on
             // new line
-            if (!newLine) word = " " + word;
+            std::string word;
+            word.reserve(wordView.size() + 1);
+            if (!newLine) word += ' ';
+            word += wordView;
             newLine = false;
 
             // update capitalization
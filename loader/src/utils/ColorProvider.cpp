@@ -1,23 +1,259 @@
 #include <Geode/utils/ColorProvider.hpp>
 #include <Geode/utils/cocos.hpp>
+#include <Geode/utils/ranges.hpp>
 
 using namespace geode::prelude;
 
+namespace {
+    // Color listeners indexed by color ID, so providing a color only goes
+    // through the listeners of that color instead of comparing the IDs of
+    // every color listener in the game. Theme listeners are kept separately.
+    // The locking scheme is the same as DefaultEventListenerPool's.
+    // Events are passed on to the default pool afterwards, since listeners 
+    // from mods built against older headers (and any generic listeners for 
+    // these events) are registered there
+    class ColorProvidedListenerPool final : public EventListenerPool {
+    private:
+        // nullopt for theme listeners
+        using Location = std::optional<std::string>;
+
+        std::mutex m_mutex;
+        size_t m_locked = 0;
+        bool m_hasRemoved = false;
+        std::unordered_map<std::string, std::vector<EventListenerProtocol*>> m_colors;
+        std::vector<EventListenerProtocol*> m_theme;
+        std::unordered_map<EventListenerProtocol*, Location> m_locations;
+        std::vector<std::pair<EventListenerProtocol*, Location>> m_toAdd;
+
+        static std::optional<Location> locationOf(EventListenerProtocol* listener) {
+            if (auto l = typeinfo_cast<EventListener<ColorProvidedFilter>*>(listener)) {
+                return Location(l->getFilter().getID());
+            }
+            if (typeinfo_cast<EventListener<ColorThemeAppliedFilter>*>(listener)) {
+                return Location(std::nullopt);
+            }
+            return std::nullopt;
+        }
+        std::vector<EventListenerProtocol*>& bucketFor(Location const& loc) {
+            return loc ? m_colors[*loc] : m_theme;
+        }
+
+        bool isRegistered(EventListenerProtocol* listener) const {
+            return m_locations.contains(listener) || ranges::contains(
+                m_toAdd, [listener](auto const& pair) { return pair.first == listener; }
+            );
+        }
+        void insert(EventListenerProtocol* listener, Location&& loc) {
+            if (m_locked) {
+                m_toAdd.push_back({ listener, std::move(loc) });
+                return;
+            }
+            // insert listeners at the start so new listeners get priority
+            auto& bucket = this->bucketFor(loc);
+            bucket.insert(bucket.begin(), listener);
+            m_locations.emplace(listener, std::move(loc));
+        }
+        void erase(EventListenerProtocol* listener) {
+            ranges::remove(m_toAdd, [listener](auto const& pair) { return pair.first == listener; });
+            auto it = m_locations.find(listener);
+            if (it == m_locations.end()) {
+                return;
+            }
+            // The bucket already exists so this doesn't modify the map
+            auto& bucket = this->bucketFor(it->second);
+            if (m_locked) {
+                std::replace(bucket.begin(), bucket.end(), listener, static_cast<EventListenerProtocol*>(nullptr));
+                m_hasRemoved = true;
+            }
+            else {
+                ranges::remove(bucket, listener);
+            }
+            m_locations.erase(it);
+        }
+        // Only mutate the buckets once nothing is iterating them
+        void flush() {
+            if (m_hasRemoved) {
+                for (auto& [id, bucket] : m_colors) {
+                    ranges::remove(bucket, nullptr);
+                }
+                ranges::remove(m_theme, nullptr);
+                m_hasRemoved = false;
+            }
+            auto toAdd = std::move(m_toAdd);
+            m_toAdd.clear();
+            for (auto& [listener, loc] : toAdd) {
+                this->insert(listener, std::move(loc));
+            }
+        }
+
+        // Expects m_mutex to be locked through `lock` and m_locked to be set
+        ListenerResult dispatch(
+            std::unique_lock<std::mutex>& lock,
+            std::vector<EventListenerProtocol*> const& bucket,
+            Event* event
+        ) {
+            // Buckets can't be resized while locked, but they can have
+            // listeners nulled out, so iterate by index
+            for (size_t i = 0; i < bucket.size(); i += 1) {
+                auto h = bucket.at(i);
+                lock.unlock();
+                auto res = h ? h->handle(event) : ListenerResult::Propagate;
+                lock.lock();
+                if (res == ListenerResult::Stop) {
+                    return ListenerResult::Stop;
+                }
+            }
+            return ListenerResult::Propagate;
+        }
+
+    public:
+        static ColorProvidedListenerPool* get() {
+            static auto inst = new ColorProvidedListenerPool();
+            return inst;
+        }
+
+        bool add(EventListenerProtocol* listener) override {
+            auto loc = locationOf(listener);
+            if (!loc) {
+                return false;
+            }
+            std::unique_lock lock(m_mutex);
+            if (this->isRegistered(listener)) {
+                return false;
+            }
+            this->insert(listener, std::move(*loc));
+            return true;
+        }
+        void remove(EventListenerProtocol* listener) override {
+            std::unique_lock lock(m_mutex);
+            this->erase(listener);
+        }
+        // Move a listener to the right bucket if its filter has been replaced
+        void update(EventListenerProtocol* listener) {
+            std::unique_lock lock(m_mutex);
+            if (!this->isRegistered(listener)) {
+                return;
+            }
+            auto loc = locationOf(listener);
+            this->erase(listener);
+            if (loc) {
+                this->insert(listener, std::move(*loc));
+            }
+        }
+
+        ListenerResult handle(Event* event) override {
+            if (auto ev = typeinfo_cast<ColorThemeAppliedEvent*>(event)) {
+                // Let the listeners of each color know their color changed
+                // before announcing the whole theme. These also go to the 
+                // default pool, where listeners from mods built against 
+                // older headers are. A listener stopping one of these only 
+                // stops that color's event, as that's all it listens to
+                for (auto& [id, color] : ev->colors) {
+                    auto single = ColorProvidedEvent(id, color);
+                    (void)this->handle(&single);
+                }
+            }
+            if (this->handleKeyed(event) == ListenerResult::Stop) {
+                return ListenerResult::Stop;
+            }
+            return DefaultEventListenerPool::get()->handle(event);
+        }
+
+    private:
+        ListenerResult handleKeyed(Event* event) {
+            std::unique_lock lock(m_mutex);
+            auto res = ListenerResult::Propagate;
+            m_locked += 1;
+            if (auto ev = typeinfo_cast<ColorProvidedEvent*>(event)) {
+                auto bucket = m_colors.find(ev->id);
+                if (bucket != m_colors.end()) {
+                    res = this->dispatch(lock, bucket->second, event);
+                }
+            }
+            else if (typeinfo_cast<ColorThemeAppliedEvent*>(event)) {
+                res = this->dispatch(lock, m_theme, event);
+            }
+            m_locked -= 1;
+            if (m_locked == 0) {
+                this->flush();
+            }
+            return res;
+        }
+    };
+}
+
 ColorProvidedEvent::ColorProvidedEvent(std::string const& id, cocos2d::ccColor4B const& color)
   : id(id), color(color) {}
 
+EventListenerPool* ColorProvidedEvent::getPool() const {
+    return ColorProvidedListenerPool::get();
+}
+
 ListenerResult ColorProvidedFilter::handle(MiniFunction<Callback> fn, ColorProvidedEvent* event) {
+    // ColorProvidedListenerPool already only routes events to listeners 
+    // whose ID matches, but listeners registered in the default pool get 
+    // every color's changes
     if (event->id == m_id) {
         fn(event);
     }
     return ListenerResult::Propagate;
 }
+EventListenerPool* ColorProvidedFilter::getPool() const {
+    return ColorProvidedListenerPool::get();
+}
+void ColorProvidedFilter::setListener(EventListenerProtocol* listener) {
+    m_listener = listener;
+    if (listener) {
+        ColorProvidedListenerPool::get()->update(listener);
+    }
+}
+
+std::string const& ColorProvidedFilter::getID() const {
+    return m_id;
+}
 
 ColorProvidedFilter::ColorProvidedFilter(std::string const& id) : m_id(id) {}
 
+ColorThemeAppliedEvent::ColorThemeAppliedEvent(std::vector<std::pair<std::string, cocos2d::ccColor4B>>&& colors)
+  : colors(std::move(colors)) {}
+
+EventListenerPool* ColorThemeAppliedEvent::getPool() const {
+    return ColorProvidedListenerPool::get();
+}
+
+ListenerResult ColorThemeAppliedFilter::handle(MiniFunction<Callback> fn, ColorThemeAppliedEvent* event) {
+    fn(event);
+    return ListenerResult::Propagate;
+}
+EventListenerPool* ColorThemeAppliedFilter::getPool() const {
+    return ColorProvidedListenerPool::get();
+}
+void ColorThemeAppliedFilter::setListener(EventListenerProtocol* listener) {
+    m_listener = listener;
+    if (listener) {
+        ColorProvidedListenerPool::get()->update(listener);
+    }
+}
+
 class ColorProvider::Impl {
 public:
-    std::unordered_map<std::string, std::pair<ccColor4B, std::optional<ccColor4B>>> colors;
+    struct Entry final {
+        ccColor4B defined;
+        std::optional<ccColor4B> overridden;
+
+        ccColor4B current() const {
+            return overridden.value_or(defined);
+        }
+    };
+
+    // Colors are never removed, so their index doubles as their handle
+    std::vector<Entry> colors;
+    std::unordered_map<std::string, uint32_t> indices;
+
+    Entry* find(std::string const& id) {
+        auto it = indices.find(id);
+        return it != indices.end() ? &colors[it->second] : nullptr;
+    }
 };
 
 ColorProvider::ColorProvider() : m_impl(new Impl()) {}
@@ -28,16 +264,19 @@ ColorProvider* ColorProvider::get() {
 }
 
 ccColor4B ColorProvider::define(std::string const& id, ccColor4B const& color) {
-    // `insert` doesn't override existing keys, which is what we want
-    m_impl->colors.insert({ id, std::pair(color, std::nullopt) });
-    return this->color(id);
+    // `try_emplace` doesn't override existing keys, which is what we want
+    auto [it, inserted] = m_impl->indices.try_emplace(id, static_cast<uint32_t>(m_impl->colors.size()));
+    if (inserted) {
+        m_impl->colors.push_back({ color, std::nullopt });
+    }
+    return m_impl->colors[it->second].current();
 }
 ccColor3B ColorProvider::define(std::string const& id, ccColor3B const& color) {
     return to3B(this->define(id, to4B(color)));
 }
 ccColor4B ColorProvider::override(std::string const& id, ccColor4B const& color) {
-    if (m_impl->colors.contains(id)) {
-        m_impl->colors.at(id).second = color;
+    if (auto entry = m_impl->find(id)) {
+        entry->overridden = color;
         ColorProvidedEvent(id, color).post();
         return color;
     }
@@ -50,11 +289,10 @@ ccColor3B ColorProvider::override(std::string const& id, ccColor3B const& color)
     return to3B(this->override(id, to4B(color)));
 }
 ccColor4B ColorProvider::reset(std::string const& id) {
-    if (m_impl->colors.contains(id)) {
-        m_impl->colors.at(id).second = std::nullopt;
-        auto def = m_impl->colors.at(id).first;
-        ColorProvidedEvent(id, def).post();
-        return def;
+    if (auto entry = m_impl->find(id)) {
+        entry->overridden = std::nullopt;
+        ColorProvidedEvent(id, entry->defined).post();
+        return entry->defined;
     }
     else {
         log::error("(ColorProvider) Attempted to reset color \"{}\", which is not defined", id);
@@ -62,8 +300,8 @@ ccColor4B ColorProvider::reset(std::string const& id) {
     }
 }
 ccColor4B ColorProvider::color(std::string const& id) const {
-    if (m_impl->colors.contains(id)) {
-        return m_impl->colors.at(id).second.value_or(m_impl->colors.at(id).first);
+    if (auto entry = m_impl->find(id)) {
+        return entry->current();
     }
     else {
         log::error("(ColorProvider) Attempted to get color \"{}\", which is not defined", id);
@@ -73,3 +311,39 @@ ccColor4B ColorProvider::color(std::string const& id) const {
 ccColor3B ColorProvider::color3b(std::string const& id) const {
     return to3B(this->color(id));
 }
+
+std::optional<ColorHandle> ColorProvider::handle(std::string const& id) const {
+    auto it = m_impl->indices.find(id);
+    if (it != m_impl->indices.end()) {
+        return static_cast<ColorHandle>(it->second);
+    }
+    return std::nullopt;
+}
+ccColor4B ColorProvider::color(ColorHandle handle) const {
+    auto index = static_cast<uint32_t>(handle);
+    if (index < m_impl->colors.size()) {
+        return m_impl->colors[index].current();
+    }
+    log::error("(ColorProvider) Attempted to get color with invalid handle {}", index);
+    return to4B(ccWHITE);
+}
+ccColor3B ColorProvider::color3b(ColorHandle handle) const {
+    return to3B(this->color(handle));
+}
+
+void ColorProvider::applyTheme(std::vector<std::pair<std::string, std::optional<ccColor4B>>> const& colors) {
+    std::vector<std::pair<std::string, ccColor4B>> changed;
+    changed.reserve(colors.size());
+    for (auto& [id, color] : colors) {
+        auto entry = m_impl->find(id);
+        if (!entry) {
+            log::error("(ColorProvider) Attempted to apply color \"{}\", which is not defined", id);
+            continue;
+        }
+        entry->overridden = color;
+        changed.push_back({ id, entry->current() });
+    }
+    if (changed.size()) {
+        ColorThemeAppliedEvent(std::move(changed)).post();
+    }
+}
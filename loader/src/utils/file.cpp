@@ -12,6 +12,7 @@
 #include <mz_strm_mem.h>
 #include <mz_zip.h>
 #include <internal/FileWatcher.hpp>
+#include "safeWrite.hpp"
 #include <Geode/utils/ranges.hpp>
 
 #ifdef GEODE_IS_WINDOWS
@@ -95,6 +96,13 @@ Result<> utils::file::writeString(std::filesystem::path const& path, std::string
     return Ok();
 }
 
+Result<> utils::file::writeStringSafe(std::filesystem::path const& path, std::string const& data) {
+    if (auto err = platformWriteSafe(path, data)) {
+        return Err(err);
+    }
+    return Ok();
+}
+
 Result<> utils::file::writeBinary(std::filesystem::path const& path, ByteVector const& data) {
     std::ofstream file;
 #if _WIN32
@@ -0,0 +1,74 @@
+#include "safeWrite.hpp"
+
+#include <atomic>
+#include <string>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#endif
+
+char const* geode::utils::file::platformWriteSafe(std::filesystem::path const& path, std::string_view data) {
+    // Every write gets its own temporary file in case the same file is being 
+    // written from multiple threads at once
+    static std::atomic_size_t TEMP_COUNTER = 0;
+    auto temp = path;
+    temp += "." + std::to_string(TEMP_COUNTER++) + ".tmp";
+
+#ifdef _WIN32
+    auto file = CreateFileW(
+        temp.wstring().c_str(), GENERIC_WRITE, 0, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return "Unable to open file";
+    }
+    DWORD written = 0;
+    bool ok = WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) &&
+        written == data.size() &&
+        FlushFileBuffers(file);
+    CloseHandle(file);
+    if (!ok) {
+        DeleteFileW(temp.wstring().c_str());
+        return "Unable to write file";
+    }
+    if (!MoveFileExW(
+        temp.wstring().c_str(), path.wstring().c_str(),
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH
+    )) {
+        DeleteFileW(temp.wstring().c_str());
+        return "Unable to replace file";
+    }
+#else
+    auto fd = ::open(temp.string().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return "Unable to open file";
+    }
+    bool ok = true;
+    size_t offset = 0;
+    while (offset < data.size()) {
+        auto count = ::write(fd, data.data() + offset, data.size() - offset);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        offset += static_cast<size_t>(count);
+    }
+    ok = ok && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok) {
+        std::remove(temp.string().c_str());
+        return "Unable to write file";
+    }
+    if (std::rename(temp.string().c_str(), path.string().c_str()) != 0) {
+        std::remove(temp.string().c_str());
+        return "Unable to replace file";
+    }
+#endif
+    return nullptr;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+namespace geode::utils::file {
+    // The part of writeStringSafe that talks to the OS: writes the data to 
+    // a new temporary file next to `path`, flushes it to disk and moves it 
+    // over `path`, so `path` only ever has the old or the new contents. 
+    // Returns nullptr on success, or what went wrong on failure
+    char const* platformWriteSafe(std::filesystem::path const& path, std::string_view data);
+}
@@ -1,8 +1,47 @@
 #include <Geode/utils/string.hpp>
 #include <algorithm>
+#include <cstring>
 
 using namespace geode::prelude;
 
+namespace {
+    // ASCII case folding eight characters at a time. Each byte gets 0x20 
+    // flipped if it is in the range [first, last], which is calculated for 
+    // all the bytes at once without them overflowing into each other by 
+    // only looking at the low 7 bits and masking out non-ASCII bytes after
+    constexpr uint64_t ONES = 0x0101010101010101;
+    constexpr uint64_t HIGH_BITS = 0x8080808080808080;
+
+    template <char First, char Last>
+    uint64_t flipCaseInRange(uint64_t chars) {
+        auto low = chars & ~HIGH_BITS;
+        auto aboveLast = low + ONES * (0x7f - Last);
+        auto atLeastFirst = low + ONES * (0x80 - First);
+        auto inRange = (atLeastFirst ^ aboveLast) & ~chars & HIGH_BITS;
+        return chars ^ (inRange >> 2);
+    }
+
+    template <char First, char Last>
+    void flipCaseInRange(char* str, size_t size) {
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t chars;
+            std::memcpy(&chars, str + i, sizeof(chars));
+            chars = flipCaseInRange<First, Last>(chars);
+            std::memcpy(str + i, &chars, sizeof(chars));
+        }
+        for (; i < size; i += 1) {
+            if (str[i] >= First && str[i] <= Last) {
+                str[i] ^= 0x20;
+            }
+        }
+    }
+
+    constexpr char foldCase(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c ^ 0x20) : c;
+    }
+}
+
 #ifdef GEODE_IS_WINDOWS
 
     #include <Windows.h>
@@ -35,9 +74,7 @@ bool utils::string::endsWith(std::string const& str, std::string const& suffix)
 }
 
 std::string& utils::string::toLowerIP(std::string& str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](auto c) {
-        return std::tolower(c);
-    });
+    flipCaseInRange<'A', 'Z'>(str.data(), str.size());
     return str;
 }
 
@@ -47,9 +84,7 @@ std::string utils::string::toLower(std::string const& str) {
 }
 
 std::string& utils::string::toUpperIP(std::string& str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](auto c) {
-        return std::toupper(c);
-    });
+    flipCaseInRange<'a', 'z'>(str.data(), str.size());
     return str;
 }
 
@@ -76,14 +111,9 @@ std::string utils::string::replace(
 
 std::vector<std::string> utils::string::split(std::string const& str, std::string const& split) {
     std::vector<std::string> res;
-    if (str.empty()) return res;
-    auto s = str;
-    size_t pos;
-    while ((pos = s.find(split)) != std::string::npos) {
-        res.push_back(s.substr(0, pos));
-        s.erase(0, pos + split.length());
+    for (auto part : utils::string::splitView(str, split)) {
+        res.emplace_back(part);
     }
-    res.push_back(s);
     return res;
 }
 
@@ -136,10 +166,7 @@ bool utils::string::containsAll(std::string const& str, std::vector<std::string>
 }
 
 size_t utils::string::count(std::string const& str, char countC) {
-    size_t res = 0;
-    for (auto c : str)
-        if (c == countC) res++;
-    return res;
+    return std::count(str.begin(), str.end(), countC);
 }
 
 std::string& utils::string::trimLeftIP(std::string& str) {
@@ -195,8 +222,8 @@ std::string utils::string::normalize(std::string const& str) {
 
 std::strong_ordering utils::string::caseInsensitiveCompare(std::string_view str1, std::string_view str2) {
     for (size_t i = 0; i < str1.size() && i < str2.size(); i++) {
-        auto const a = std::tolower(str1[i]);
-        auto const b = std::tolower(str2[i]);
+        auto const a = foldCase(str1[i]);
+        auto const b = foldCase(str2[i]);
         if (a < b) {
             return std::strong_ordering::less;
         } else if (a > b) {
@@ -208,4 +235,35 @@ std::strong_ordering utils::string::caseInsensitiveCompare(std::string_view str1
     else if (str1.size() > str2.size())
         return std::strong_ordering::greater;
     return std::strong_ordering::equal;
-}
\ No newline at end of file
+}
+
+bool utils::string::caseInsensitiveEquals(std::string_view str1, std::string_view str2) {
+    if (str1.size() != str2.size()) {
+        return false;
+    }
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= str1.size(); i += sizeof(uint64_t)) {
+        uint64_t a, b;
+        std::memcpy(&a, str1.data() + i, sizeof(a));
+        std::memcpy(&b, str2.data() + i, sizeof(b));
+        if (a != b && flipCaseInRange<'A', 'Z'>(a) != flipCaseInRange<'A', 'Z'>(b)) {
+            return false;
+        }
+    }
+    for (; i < str1.size(); i += 1) {
+        if (foldCase(str1[i]) != foldCase(str2[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t utils::string::caseInsensitiveHash(std::string_view str) {
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325;
+    for (auto c : str) {
+        hash ^= static_cast<uint8_t>(foldCase(c));
+        hash *= 0x100000001b3;
+    }
+    return static_cast<size_t>(hash);
+}
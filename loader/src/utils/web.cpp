@@ -12,6 +12,7 @@
 #include <Geode/utils/web.hpp>
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/terminate.hpp>
+#include <Geode/utils/string.hpp>
 #include <sstream>
 
 using namespace geode::prelude;
@@ -97,6 +98,7 @@ public:
     int m_code;
     ByteVector m_data;
     std::unordered_map<std::string, std::string> m_headers;
+    std::string m_url;
 
     Result<> into(std::filesystem::path const& path) const;
 };
@@ -153,9 +155,19 @@ std::optional<std::string> WebResponse::header(std::string_view name) const {
     if (m_impl->m_headers.contains(str)) {
         return m_impl->m_headers.at(str);
     }
+    // Header names are case-insensitive (and HTTP/2 sends them all lowercase)
+    for (auto& [key, value] : m_impl->m_headers) {
+        if (utils::string::caseInsensitiveCompare(key, name) == std::strong_ordering::equal) {
+            return value;
+        }
+    }
     return std::nullopt;
 }
 
+std::string const& WebResponse::url() const {
+    return m_impl->m_url;
+}
+
 class WebProgress::Impl {
 public:
     size_t m_downloadCurrent;
@@ -256,6 +268,9 @@ WebTask WebRequest::send(std::string_view method, std::string_view url) {
             Impl* impl;
             WebTask::PostProgress progress;
             WebTask::HasBeenCancelled hasBeenCancelled;
+            // Last values reported to the progress callback, since curl calls 
+            // it periodically even when nothing has been transferred
+            double dtotal = -1, dnow = -1, utotal = -1, unow = -1;
         } responseData = {
             .response = WebResponse(),
             .impl = impl.get(),
@@ -424,6 +439,18 @@ WebTask WebRequest::send(std::string_view method, std::string_view url) {
                 return 1;
             }
 
+            // Don't bother posting progress if nothing has changed
+            if (
+                data->dtotal == dtotal && data->dnow == dnow &&
+                data->utotal == utotal && data->unow == unow
+            ) {
+                return 0;
+            }
+            data->dtotal = dtotal;
+            data->dnow = dnow;
+            data->utotal = utotal;
+            data->unow = unow;
+
             // Post progress to Promise listener
             auto progress = WebProgress();
             progress.m_impl->m_downloadTotal = dtotal;
@@ -445,6 +472,11 @@ WebTask WebRequest::send(std::string_view method, std::string_view url) {
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
         responseData.response.m_impl->m_code = static_cast<int>(code);
 
+        char* effectiveURL = nullptr;
+        if (curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &effectiveURL) == CURLE_OK && effectiveURL) {
+            responseData.response.m_impl->m_url = effectiveURL;
+        }
+
         // Free up curl memory
         curl_slist_free_all(headers);
         curl_easy_cleanup(curl);
@@ -0,0 +1,180 @@
+#include <catch2/catch.hpp>
+#include <server/DownloadChunks.hpp>
+#include <map>
+
+using namespace server;
+
+TEST_CASE("Downloads are split into consecutive chunks") {
+    auto chunks = planDownloadChunks(10, 4);
+    REQUIRE(chunks.size() == 3);
+    CHECK(chunks[0].offset == 0);
+    CHECK(chunks[0].size == 4);
+    CHECK(chunks[0].last() == 3);
+    CHECK(chunks[1].offset == 4);
+    CHECK(chunks[1].last() == 7);
+    // The last chunk only gets what's left
+    CHECK(chunks[2].offset == 8);
+    CHECK(chunks[2].size == 2);
+    CHECK(chunks[2].last() == 9);
+}
+
+TEST_CASE("Chunks cover the whole download exactly") {
+    for (size_t size : { 1, 1023, 1024, 1025, 4096, 5000 }) {
+        auto chunks = planDownloadChunks(size, 1024);
+        size_t next = 0;
+        for (auto& chunk : chunks) {
+            CHECK(chunk.offset == next);
+            CHECK(chunk.size > 0);
+            CHECK(chunk.size <= 1024);
+            next = chunk.last() + 1;
+        }
+        CHECK(next == size);
+    }
+}
+
+TEST_CASE("Empty downloads have no chunks") {
+    CHECK(planDownloadChunks(0, 1024).empty());
+    CHECK(planDownloadChunks(1024, 0).empty());
+}
+
+TEST_CASE("Only large downloads from servers that accept ranges are chunked") {
+    CHECK(shouldDownloadInChunks(100, "bytes", 100));
+    CHECK_FALSE(shouldDownloadInChunks(99, "bytes", 100));
+    CHECK_FALSE(shouldDownloadInChunks(std::nullopt, "bytes", 100));
+    CHECK_FALSE(shouldDownloadInChunks(100, "none", 100));
+    CHECK_FALSE(shouldDownloadInChunks(100, std::nullopt, 100));
+}
+
+TEST_CASE("Download percentage") {
+    CHECK(downloadPercentage(0, 200) == 0);
+    CHECK(downloadPercentage(100, 200) == 50);
+    CHECK(downloadPercentage(200, 200) == 100);
+    // Progress reports may overshoot, and the size may be unknown
+    CHECK(downloadPercentage(300, 200) == 100);
+    CHECK(downloadPercentage(10, 0) == 0);
+}
+
+namespace {
+    // Stands in for the web requests ModDownload makes for the chunks
+    struct FakeServer final {
+        std::vector<uint8_t> file;
+        bool acceptsRanges = true;
+        size_t requests = 0;
+
+        explicit FakeServer(size_t size) {
+            for (size_t i = 0; i < size; i += 1) {
+                file.push_back(static_cast<uint8_t>(i * 31 + 7));
+            }
+        }
+
+        std::pair<int, std::vector<uint8_t>> get(DownloadChunkRange const& range) {
+            requests += 1;
+            if (!acceptsRanges) {
+                return { 200, file };
+            }
+            auto begin = file.begin() + range.offset;
+            return { 206, std::vector<uint8_t>(begin, begin + range.size) };
+        }
+    };
+
+    // Runs a download to completion, answering the running requests in 
+    // reverse order each round so the chunks finish out of order
+    std::vector<uint8_t> download(
+        FakeServer& server, ChunkedDownload& chunked, std::map<size_t, std::vector<uint8_t>>& parts
+    ) {
+        while (!chunked.isFinished()) {
+            auto running = chunked.startNext();
+            REQUIRE(!running.empty());
+            for (auto it = running.rbegin(); it != running.rend(); ++it) {
+                auto [code, data] = server.get(chunked.getRange(*it));
+                REQUIRE(chunked.onResponse(*it, code, data.size()) == ChunkedDownload::Response::Finished);
+                parts[*it] = std::move(data);
+            }
+        }
+        std::vector<uint8_t> result;
+        for (auto& [_, part] : parts) {
+            result.insert(result.end(), part.begin(), part.end());
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Chunks fetched in parallel are put back together in order") {
+    FakeServer server(10'000);
+    ChunkedDownload chunked(server.file.size(), 1024, 4);
+    std::map<size_t, std::vector<uint8_t>> parts;
+    CHECK(download(server, chunked, parts) == server.file);
+    CHECK(server.requests == 10);
+    CHECK(chunked.getDownloaded() == server.file.size());
+    CHECK(chunked.getPercentage() == 100);
+}
+
+TEST_CASE("No more than the maximum number of chunks are fetched at once") {
+    ChunkedDownload chunked(10'000, 1024, 4);
+    CHECK(chunked.startNext() == std::vector<size_t> { 0, 1, 2, 3 });
+    CHECK(chunked.startNext().empty());
+    CHECK(chunked.onResponse(2, 206, 1024) == ChunkedDownload::Response::Finished);
+    CHECK(chunked.startNext() == std::vector<size_t> { 4 });
+}
+
+TEST_CASE("Resumed downloads only fetch the chunks that are missing") {
+    FakeServer server(5000);
+    ChunkedDownload chunked(server.file.size(), 1024, 2);
+
+    // Chunks kept on disk by an earlier attempt
+    std::map<size_t, std::vector<uint8_t>> parts;
+    for (size_t i : { 0, 3 }) {
+        auto range = chunked.getRange(i);
+        parts[i] = server.get(range).second;
+        chunked.markFinished(i);
+    }
+    server.requests = 0;
+    CHECK(chunked.getFinishedCount() == 2);
+    CHECK(chunked.getDownloaded() == 2048);
+
+    CHECK(download(server, chunked, parts) == server.file);
+    CHECK(server.requests == 3);
+}
+
+TEST_CASE("Stopped chunks are fetched again from the start") {
+    ChunkedDownload chunked(4096, 1024, 4);
+    auto running = chunked.startNext();
+    chunked.onProgress(1, 512);
+    CHECK(chunked.getDownloaded() == 512);
+    for (auto i : running) {
+        chunked.onStopped(i);
+    }
+    CHECK(chunked.getDownloaded() == 0);
+    CHECK(chunked.startNext() == running);
+}
+
+TEST_CASE("Progress is capped at the size of the chunk") {
+    ChunkedDownload chunked(2048, 1024, 2);
+    chunked.startNext();
+    chunked.onProgress(0, 5000);
+    CHECK(chunked.getDownloaded() == 1024);
+    CHECK(chunked.getPercentage() == 50);
+}
+
+TEST_CASE("A server that ignores ranges means downloading the whole file") {
+    FakeServer server(5000);
+    server.acceptsRanges = false;
+    ChunkedDownload chunked(server.file.size(), 1024, 4);
+    auto i = chunked.startNext().front();
+    auto [code, data] = server.get(chunked.getRange(i));
+    CHECK(chunked.onResponse(i, code, data.size()) == ChunkedDownload::Response::WholeFile);
+    CHECK_FALSE(chunked.isFinished());
+    CHECK(chunked.getFinishedCount() == 0);
+}
+
+TEST_CASE("Errors and partial ranges fail the chunk") {
+    ChunkedDownload chunked(4096, 1024, 4);
+    chunked.startNext();
+    CHECK(chunked.onResponse(0, 416, 0) == ChunkedDownload::Response::Failed);
+    CHECK(chunked.onResponse(1, 206, 1000) == ChunkedDownload::Response::Failed);
+    CHECK(chunked.onResponse(2, 404, 1024) == ChunkedDownload::Response::Failed);
+    // Chunks that weren't requested can't get responses either
+    CHECK(chunked.onResponse(3, 206, 1024) == ChunkedDownload::Response::Finished);
+    CHECK(chunked.onResponse(3, 206, 1024) == ChunkedDownload::Response::Failed);
+    CHECK(chunked.getFinishedCount() == 1);
+}
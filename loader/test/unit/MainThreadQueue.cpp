@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+#include <loader/MainThreadQueue.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace geode;
+using namespace std::chrono_literals;
+
+TEST_CASE("Queued functions run in priority order") {
+    MainThreadQueue queue;
+    std::vector<int> order;
+    queue.push([&] { order.push_back(3); }, MainThreadPriority::Low);
+    queue.push([&] { order.push_back(2); }, MainThreadPriority::Normal);
+    queue.push([&] { order.push_back(1); }, MainThreadPriority::High);
+    queue.push([&] { order.push_back(4); }, MainThreadPriority::Low);
+    queue.execute();
+    CHECK(order == std::vector { 1, 2, 3, 4 });
+    CHECK(queue.getStats().executed == 4);
+}
+
+TEST_CASE("Functions queued while running wait for the next frame") {
+    MainThreadQueue queue;
+    int runs = 0;
+    queue.push([&] {
+        runs += 1;
+        queue.push([&] { runs += 1; }, MainThreadPriority::High);
+    }, MainThreadPriority::Normal);
+    queue.execute();
+    CHECK(runs == 1);
+    CHECK(queue.getStats().pending == 1);
+    queue.execute();
+    CHECK(runs == 2);
+    CHECK(queue.getStats().pending == 0);
+}
+
+TEST_CASE("The time budget defers functions to the next frame") {
+    MainThreadQueue queue;
+    queue.setBudget(1ms);
+    size_t runs = 0;
+    for (size_t i = 0; i < 10; i += 1) {
+        queue.push([&] {
+            runs += 1;
+            std::this_thread::sleep_for(2ms);
+        }, MainThreadPriority::Normal);
+    }
+    // At least one function runs every frame even if it's over the budget
+    queue.execute();
+    CHECK(runs == 1);
+    CHECK(queue.getStats().deferred == 9);
+    CHECK(queue.getStats().pending == 9);
+
+    queue.setBudget(std::nullopt);
+    queue.execute();
+    CHECK(runs == 10);
+    CHECK(queue.getStats().deferred == 0);
+}
+
+TEST_CASE("High priority functions aren't deferred") {
+    MainThreadQueue queue;
+    queue.setBudget(1ms);
+    std::vector<int> order;
+    queue.push([&] {
+        order.push_back(1);
+        std::this_thread::sleep_for(2ms);
+    }, MainThreadPriority::High);
+    queue.push([&] { order.push_back(2); }, MainThreadPriority::High);
+    queue.push([&] { order.push_back(3); }, MainThreadPriority::Normal);
+    queue.execute();
+    CHECK(order == std::vector { 1, 2 });
+
+    // Deferred functions still run before ones queued after them
+    queue.push([&] { order.push_back(4); }, MainThreadPriority::Normal);
+    queue.execute();
+    CHECK(order == std::vector { 1, 2, 3, 4 });
+}
+
+TEST_CASE("Functions can be queued from other threads") {
+    MainThreadQueue queue;
+    std::atomic_size_t runs = 0;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i += 1) {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < 100; j += 1) {
+                queue.push([&] { runs += 1; }, MainThreadPriority::Normal);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    queue.execute();
+    CHECK(runs == 400);
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+#include <loader/ModDataStoreFormat.hpp>
+
+using namespace geode;
+using Kind = ModDataStoreFormat::Kind;
+
+static std::string makeStore(std::initializer_list<std::tuple<std::string, Kind, std::string>> records) {
+    std::string data(ModDataStoreFormat::STORE_HEADER);
+    for (auto& [id, kind, value] : records) {
+        ModDataStoreFormat::appendRecord(data, id, kind, value);
+    }
+    return data;
+}
+
+TEST_CASE("Records are read back as written") {
+    auto data = makeStore({
+        { "geode.loader", Kind::Settings, "{\"a\":1}" },
+        { "geode.loader", Kind::SavedValues, "{}" },
+        { "someone.mod", Kind::SavedValues, std::string("\0bin\0", 5) },
+    });
+    ModDataStoreFormat::Entries entries;
+    CHECK(ModDataStoreFormat::parse(data, entries) == data.size());
+    REQUIRE(entries.size() == 2);
+    CHECK(entries["geode.loader"].settings == "{\"a\":1}");
+    CHECK(entries["geode.loader"].savedValues == "{}");
+    CHECK_FALSE(entries["someone.mod"].settings.has_value());
+    CHECK(entries["someone.mod"].savedValues == std::string("\0bin\0", 5));
+}
+
+TEST_CASE("Later records replace earlier ones") {
+    auto data = makeStore({
+        { "a", Kind::Settings, "old" },
+        { "a", Kind::SavedValues, "kept" },
+        { "a", Kind::Settings, "new" },
+    });
+    ModDataStoreFormat::Entries entries;
+    REQUIRE(ModDataStoreFormat::parse(data, entries));
+    CHECK(entries["a"].settings == "new");
+    CHECK(entries["a"].savedValues == "kept");
+}
+
+TEST_CASE("Erase records remove all of a mod's data") {
+    auto data = makeStore({
+        { "a", Kind::Settings, "1" },
+        { "b", Kind::Settings, "2" },
+        { "a", Kind::Erase, "" },
+        { "b", Kind::SavedValues, "3" },
+    });
+    ModDataStoreFormat::Entries entries;
+    REQUIRE(ModDataStoreFormat::parse(data, entries));
+    CHECK_FALSE(entries.contains("a"));
+    CHECK(entries["b"].settings == "2");
+    CHECK(entries["b"].savedValues == "3");
+}
+
+TEST_CASE("Files without the header aren't parsed") {
+    ModDataStoreFormat::Entries entries;
+    CHECK_FALSE(ModDataStoreFormat::parse("", entries));
+    CHECK_FALSE(ModDataStoreFormat::parse("{\"not\":\"a store\"}", entries));
+    CHECK_FALSE(ModDataStoreFormat::parse(std::string_view("GMDS\x02\0\0\0", 8), entries));
+    CHECK(entries.empty());
+}
+
+TEST_CASE("An incomplete last record is dropped") {
+    auto complete = makeStore({ { "a", Kind::Settings, "1" } });
+    auto data = complete;
+    ModDataStoreFormat::appendRecord(data, "b", Kind::Settings, "some longer data");
+    // Cut off in the middle of the data, and in the middle of the record header
+    for (auto cut : { size_t(4), ModDataStoreFormat::RECORD_HEADER_SIZE + 12 }) {
+        ModDataStoreFormat::Entries entries;
+        auto truncated = std::string_view(data).substr(0, complete.size() + cut);
+        CHECK(ModDataStoreFormat::parse(truncated, entries) == complete.size());
+        CHECK(entries.size() == 1);
+        CHECK(entries["a"].settings == "1");
+    }
+}
+
+TEST_CASE("Compacting keeps only the latest data") {
+    auto data = makeStore({
+        { "a", Kind::Settings, "old" },
+        { "a", Kind::Settings, "new" },
+        { "b", Kind::SavedValues, "x" },
+        { "c", Kind::Settings, "gone" },
+        { "c", Kind::Erase, "" },
+    });
+    ModDataStoreFormat::Entries entries;
+    REQUIRE(ModDataStoreFormat::parse(data, entries));
+
+    auto compacted = ModDataStoreFormat::compact(entries);
+    CHECK(compacted.size() == ModDataStoreFormat::compactedSize(entries));
+    CHECK(compacted.size() < data.size());
+
+    ModDataStoreFormat::Entries reparsed;
+    CHECK(ModDataStoreFormat::parse(compacted, reparsed) == compacted.size());
+    REQUIRE(reparsed.size() == 2);
+    CHECK(reparsed["a"].settings == "new");
+    CHECK(reparsed["b"].savedValues == "x");
+}
+
+TEST_CASE("Compacting an empty store gives an empty file") {
+    CHECK(ModDataStoreFormat::compact({}).empty());
+    CHECK(ModDataStoreFormat::compactedSize({}) == 0);
+}
+
+TEST_CASE("Stores are compacted at twice the size of their data") {
+    // A missing file is always written in full
+    CHECK(ModDataStoreFormat::shouldCompact(0, 10, 100));
+    CHECK_FALSE(ModDataStoreFormat::shouldCompact(100, 0, 100));
+    CHECK_FALSE(ModDataStoreFormat::shouldCompact(150, 50, 100));
+    CHECK(ModDataStoreFormat::shouldCompact(150, 51, 100));
+    // Everything was erased
+    CHECK(ModDataStoreFormat::shouldCompact(100, 9, 0));
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch.hpp>
+#include <ui/mods/sources/ModSearchIndex.hpp>
+
+static ModSearchIndex::Entry makeEntry() {
+    ModSearchIndex::Entry entry;
+    entry.name = "Better Level Browser";
+    ModSearchIndex::addField(entry, "Better Level Browser", 1);
+    ModSearchIndex::addField(entry, "someone.better-browser", 0.5);
+    ModSearchIndex::addField(entry, "Someone", 0.25);
+    return entry;
+}
+
+TEST_CASE("Character sets are case-insensitive") {
+    auto chars = ModSearchIndex::charsOf("aB");
+    CHECK(chars.test('a'));
+    CHECK(chars.test('b'));
+    CHECK_FALSE(chars.test('A'));
+    CHECK_FALSE(chars.test('B'));
+    CHECK(chars.count() == 2);
+}
+
+TEST_CASE("Fields add to the entry's character set") {
+    auto entry = makeEntry();
+    REQUIRE(entry.fields.size() == 3);
+    for (auto& field : entry.fields) {
+        CHECK((entry.chars & field.chars) == field.chars);
+    }
+    CHECK(entry.chars.test('.'));
+    CHECK(entry.chars.test('-'));
+}
+
+TEST_CASE("Mods are matched by their fields") {
+    auto entry = makeEntry();
+    double weighted = 0;
+    CHECK(modFuzzyMatch(entry, ModSearchIndex::createQuery("level browser"), weighted));
+    CHECK(weighted >= 2);
+}
+
+TEST_CASE("Queries with characters a mod doesn't have never match it") {
+    auto entry = makeEntry();
+    double weighted = 0;
+    CHECK_FALSE(modFuzzyMatch(entry, ModSearchIndex::createQuery("xyz"), weighted));
+    CHECK(weighted == 0);
+}
+
+TEST_CASE("Better matching fields score higher") {
+    ModSearchIndex::Entry byName;
+    ModSearchIndex::addField(byName, "Cool Mod", 1);
+    ModSearchIndex::Entry byDeveloper;
+    ModSearchIndex::addField(byDeveloper, "Unrelated", 1);
+    ModSearchIndex::addField(byDeveloper, "Cool Mod", 0.25);
+
+    auto query = ModSearchIndex::createQuery("cool");
+    double nameScore = 0, developerScore = 0;
+    modFuzzyMatch(byName, query, nameScore);
+    modFuzzyMatch(byDeveloper, query, developerScore);
+    CHECK(nameScore > developerScore);
+}
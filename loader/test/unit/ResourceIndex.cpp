@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+#include <cocos2d-ext/ResourceIndex.hpp>
+#include "TempDir.hpp"
+
+using namespace geode;
+
+namespace {
+    // The search paths of a game with two extracted mods, in the same form 
+    // as cocos' search paths
+    struct Resources final {
+        TempDir dir;
+        std::string game;
+        std::string modA;
+        std::string modB;
+
+        Resources() {
+            dir.create("resources/game.png");
+            dir.create("resources/shared.png");
+            dir.create("runtime/mod.a/resources/a.png");
+            dir.create("runtime/mod.a/resources/shared.png");
+            dir.create("runtime/mod.a/resources/sub/nested.plist");
+            dir.create("runtime/mod.b/resources/b.png");
+            dir.create("runtime/mod.b/resources/b-hd.png");
+            dir.create("runtime/mod.b/resources/a.png");
+            game = (dir.path / "resources" / "").string();
+            modA = (dir.path / "runtime" / "mod.a" / "resources" / "").string();
+            modB = (dir.path / "runtime" / "mod.b" / "resources" / "").string();
+        }
+
+        ResourceIndex index() const {
+            return ResourceIndex(dir.path / "runtime");
+        }
+    };
+}
+
+TEST_CASE("Files in mods' directories are found through the index") {
+    Resources res;
+    auto index = res.index();
+    std::vector<std::string> paths { res.modA, res.modB, res.game };
+    CHECK(index.lookup(paths, "a.png") == res.modA + "a.png");
+    CHECK(index.lookup(paths, "sub/nested.plist") == res.modA + "sub/nested.plist");
+    CHECK(index.getIndexedFileCount() == 5);
+    CHECK(index.getUnindexedPathCount() == 1);
+}
+
+TEST_CASE("Earlier search paths win") {
+    Resources res;
+    auto index = res.index();
+    CHECK(index.lookup(std::vector { res.modB, res.modA }, "a.png") == res.modB + "a.png");
+    // Unindexed paths are checked on disk, but only up to the indexed hit
+    CHECK(index.lookup(std::vector { res.game, res.modA }, "shared.png") == res.game + "shared.png");
+    CHECK(index.lookup(std::vector { res.modA, res.game }, "shared.png") == res.modA + "shared.png");
+    CHECK(index.lookup(std::vector { res.modA, res.game }, "game.png") == res.game + "game.png");
+}
+
+TEST_CASE("Misses are left to cocos") {
+    Resources res;
+    auto index = res.index();
+    std::vector<std::string> paths { res.modA, res.modB, res.game };
+    CHECK_FALSE(index.lookup(paths, "missing.png"));
+    // The quality-suffixed version exists, so GD gets to pick
+    CHECK_FALSE(index.lookup(paths, "b.png"));
+    // Paths that aren't resolved relative to the search paths
+    CHECK_FALSE(index.lookup(paths, ""));
+    CHECK_FALSE(index.lookup(paths, "/a.png"));
+    CHECK_FALSE(index.lookup(paths, "./a.png"));
+    CHECK_FALSE(index.lookup(paths, "../mod.a/resources/a.png"));
+    CHECK_FALSE(index.lookup(paths, "sub\\nested.plist"));
+    // Relative search paths can't be checked on disk
+    CHECK_FALSE(index.lookup(std::vector<std::string> { "assets/", res.modA }, "a.png"));
+}
+
+TEST_CASE("The root of the immutable directory isn't indexed") {
+    Resources res;
+    auto index = res.index();
+    auto root = (res.dir.path / "runtime" / "").string();
+    // It's still found, but by checking the disk
+    CHECK(index.lookup(std::vector { root }, "mod.a/resources/a.png") == root + "mod.a/resources/a.png");
+    CHECK(index.getIndexedFileCount() == 0);
+    CHECK(index.getUnindexedPathCount() == 1);
+}
+
+TEST_CASE("The index follows changes to the search paths") {
+    Resources res;
+    auto index = res.index();
+    CHECK_FALSE(index.lookup(std::vector { res.modA }, "b-hd.png"));
+    CHECK(index.lookup(std::vector { res.modA, res.modB }, "b-hd.png") == res.modB + "b-hd.png");
+    CHECK(index.lookup(std::vector { res.modB }, "a.png") == res.modB + "a.png");
+}
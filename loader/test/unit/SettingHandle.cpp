@@ -0,0 +1,49 @@
+#include <catch2/catch.hpp>
+#include <Geode/loader/SettingHandle.hpp>
+#include <string>
+
+using namespace geode;
+
+namespace {
+    // Stands in for a real setting, which only needs to expose a reference 
+    // to its value for handles
+    struct FakeSetting final {
+        std::string value;
+        std::string const& getValueRef() const {
+            return value;
+        }
+    };
+    using Handle = SettingHandle<std::string, FakeSetting>;
+}
+
+TEST_CASE("Empty setting handles read the default value") {
+    Handle empty;
+    CHECK_FALSE(empty);
+    CHECK(empty.get().empty());
+    CHECK(empty->empty());
+    CHECK(empty.getSetting() == nullptr);
+
+    Handle null(nullptr);
+    CHECK_FALSE(null);
+    CHECK(null.get().empty());
+}
+
+TEST_CASE("Setting handles read the setting's current value") {
+    auto setting = std::make_shared<FakeSetting>(FakeSetting { "hi" });
+    Handle handle(setting);
+    REQUIRE(handle);
+    CHECK(handle.getSetting() == setting);
+    CHECK(*handle == "hi");
+
+    // No need to refresh the handle after the value changes
+    setting->value = "bye";
+    CHECK(handle.get() == "bye");
+    CHECK(handle->size() == 3);
+}
+
+TEST_CASE("Setting handles keep their setting alive") {
+    auto setting = std::make_shared<FakeSetting>(FakeSetting { "kept" });
+    Handle handle(setting);
+    setting.reset();
+    CHECK(handle.get() == "kept");
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+// A fresh directory for a single test, which is removed afterwards
+struct TempDir final {
+    std::filesystem::path path;
+
+    TempDir() {
+        path = std::filesystem::temp_directory_path() /
+            ("geode-unit-" + std::to_string(std::random_device()()));
+        std::filesystem::create_directories(path);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+    TempDir(TempDir const&) = delete;
+    TempDir& operator=(TempDir const&) = delete;
+
+    size_t fileCount() const {
+        return std::distance(
+            std::filesystem::directory_iterator(path), std::filesystem::directory_iterator()
+        );
+    }
+    // Create a file, along with any directories it's in
+    std::filesystem::path create(std::filesystem::path const& relative, std::string const& data = "") const {
+        auto full = path / relative;
+        std::filesystem::create_directories(full.parent_path());
+        std::ofstream(full, std::ios::binary) << data;
+        return full;
+    }
+};
@@ -0,0 +1,72 @@
+#include "AllocationProbe.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every allocation is prefixed with its size, so that deleting it knows how 
+// much to take off. The prefix is as big as the alignment malloc guarantees 
+// so the memory handed out keeps that alignment. Over-aligned allocations go 
+// through the align_val_t overloads, which aren't replaced and so aren't 
+// counted
+
+static std::atomic_size_t s_live = 0;
+static std::atomic_size_t s_allocations = 0;
+
+static constexpr size_t PREFIX_SIZE = alignof(std::max_align_t);
+
+static void* allocate(size_t size) noexcept {
+    auto ptr = static_cast<char*>(std::malloc(size + PREFIX_SIZE));
+    if (!ptr) {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(ptr) = size;
+    s_live += size;
+    s_allocations += 1;
+    return ptr + PREFIX_SIZE;
+}
+static void deallocate(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    auto start = static_cast<char*>(ptr) - PREFIX_SIZE;
+    s_live -= *reinterpret_cast<size_t*>(start);
+    std::free(start);
+}
+
+void* operator new(size_t size) {
+    if (auto ptr = allocate(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+void* operator new(size_t size, std::nothrow_t const&) noexcept {
+    return allocate(size);
+}
+void* operator new[](size_t size, std::nothrow_t const&) noexcept {
+    return allocate(size);
+}
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+void operator delete(void* ptr, std::nothrow_t const&) noexcept {
+    deallocate(ptr);
+}
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept {
+    deallocate(ptr);
+}
+
+AllocationProbe AllocationProbe::get() {
+    return AllocationProbe { s_live, s_allocations };
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+// Tracks the memory the process allocates through operator new, by 
+// replacing it (see AllocationProbe.cpp). How much memory something holds 
+// is the same on every machine, so it's reported as a counter
+struct AllocationProbe final {
+    // Bytes allocated and not yet freed
+    size_t live = 0;
+    size_t allocations = 0;
+
+    static AllocationProbe get();
+    AllocationProbe operator-(AllocationProbe const& other) const {
+        return AllocationProbe { live - other.live, allocations - other.allocations };
+    }
+};
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <Geode/loader/Event.hpp>
+#include <memory>
+
+using namespace geode::prelude;
+
+namespace {
+    struct BenchEvent final : public Event {
+        int value;
+        BenchEvent(int value) : value(value) {}
+    };
+    struct OtherEvent final : public Event {};
+
+    // Only takes the events with its own value, like filters that match on 
+    // an ID or a node
+    class BenchFilter final : public EventFilter<BenchEvent> {
+    public:
+        using Callback = ListenerResult(BenchEvent*);
+
+        int m_value;
+
+        BenchFilter(int value = 0) : m_value(value) {}
+
+        ListenerResult handle(utils::MiniFunction<Callback> fn, BenchEvent* event) {
+            if (event->value == m_value) {
+                return fn(event);
+            }
+            return ListenerResult::Propagate;
+        }
+    };
+}
+
+// Posting an event that one listener out of many is waiting for, which is 
+// how most events in the loader are used. Every listener in the pool is 
+// asked, including the ones for other event types
+static void BM_EventPost(benchmark::State& state) {
+    size_t handled = 0;
+    std::vector<std::unique_ptr<EventListenerProtocol>> listeners;
+    for (int i = 0; i < state.range(0); i += 1) {
+        if (i % 2) {
+            listeners.push_back(std::make_unique<EventListener<EventFilter<OtherEvent>>>(
+                +[](OtherEvent*) { return ListenerResult::Propagate; }
+            ));
+        }
+        else {
+            listeners.push_back(std::make_unique<EventListener<BenchFilter>>(
+                [&](BenchEvent*) {
+                    handled += 1;
+                    return ListenerResult::Propagate;
+                },
+                BenchFilter(i)
+            ));
+        }
+    }
+    for (auto _ : state) {
+        BenchEvent(0).post();
+    }
+    if (handled != state.iterations()) {
+        state.SkipWithError("Event wasn't handled once per post");
+    }
+}
+BENCHMARK(BM_EventPost)->Arg(1)->Arg(100)->Arg(1000);
+
+// Adding and removing a listener, which happens whenever a node that 
+// listens to something is created or destroyed
+static void BM_EventListenerLifetime(benchmark::State& state) {
+    std::vector<std::unique_ptr<EventListenerProtocol>> listeners;
+    for (int i = 0; i < state.range(0); i += 1) {
+        listeners.push_back(std::make_unique<EventListener<BenchFilter>>(
+            +[](BenchEvent*) { return ListenerResult::Propagate; }, BenchFilter(i)
+        ));
+    }
+    for (auto _ : state) {
+        EventListener<BenchFilter> listener(
+            +[](BenchEvent*) { return ListenerResult::Propagate; }, BenchFilter(-1)
+        );
+        benchmark::DoNotOptimize(listener);
+    }
+}
+BENCHMARK(BM_EventListenerLifetime)->Arg(1)->Arg(1000);
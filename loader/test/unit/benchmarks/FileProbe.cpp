@@ -0,0 +1,73 @@
+#include "FileProbe.hpp"
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+// Functions defined in the executable take precedence over libc's, also 
+// for calls from libstdc++'s filesystem functions. The real ones are 
+// looked up with RTLD_NEXT
+
+static std::atomic_size_t s_stat = 0;
+static std::atomic_size_t s_open = 0;
+
+template <class F>
+static F next(char const* name) {
+    return reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+}
+
+// Mode is only passed when a file may be created
+static mode_t modeArg(int flags, va_list args) {
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        return va_arg(args, mode_t);
+    }
+    return 0;
+}
+
+extern "C" {
+    int stat(char const* path, struct stat* buf) {
+        static auto real = next<int(*)(char const*, struct stat*)>("stat");
+        s_stat += 1;
+        return real(path, buf);
+    }
+    int lstat(char const* path, struct stat* buf) {
+        static auto real = next<int(*)(char const*, struct stat*)>("lstat");
+        s_stat += 1;
+        return real(path, buf);
+    }
+    int open(char const* path, int flags, ...) {
+        static auto real = next<int(*)(char const*, int, ...)>("open");
+        va_list args;
+        va_start(args, flags);
+        auto mode = modeArg(flags, args);
+        va_end(args);
+        s_open += 1;
+        return real(path, flags, mode);
+    }
+    int openat(int dir, char const* path, int flags, ...) {
+        static auto real = next<int(*)(int, char const*, int, ...)>("openat");
+        va_list args;
+        va_start(args, flags);
+        auto mode = modeArg(flags, args);
+        va_end(args);
+        s_open += 1;
+        return real(dir, path, flags, mode);
+    }
+    // What std::ifstream and std::ofstream open files with
+    FILE* fopen(char const* path, char const* mode) {
+        static auto real = next<FILE*(*)(char const*, char const*)>("fopen");
+        s_open += 1;
+        return real(path, mode);
+    }
+    FILE* fopen64(char const* path, char const* mode) {
+        static auto real = next<FILE*(*)(char const*, char const*)>("fopen64");
+        s_open += 1;
+        return real(path, mode);
+    }
+}
+
+FileProbe FileProbe::get() {
+    return FileProbe { s_stat, s_open };
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+// Counts the filesystem calls the process makes, by wrapping libc's stat and 
+// open functions (see FileProbe.cpp). This is what finding a file costs 
+// regardless of how fast the machine's disk is, so it's reported as a 
+// counter next to the time
+struct FileProbe final {
+    size_t stat = 0;
+    size_t open = 0;
+
+    static FileProbe get();
+    FileProbe operator-(FileProbe const& other) const {
+        return FileProbe { stat - other.stat, open - other.open };
+    }
+};
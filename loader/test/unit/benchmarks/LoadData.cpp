@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <loader/ModDataStoreFormat.hpp>
+#include "FileProbe.hpp"
+#include "TempDir.hpp"
+#include <fstream>
+
+using namespace geode;
+
+// Loading the data of a lot of installed mods on startup
+static constexpr size_t MOD_COUNT = 300;
+
+namespace {
+    struct SaveData final {
+        TempDir dir;
+        std::vector<std::string> ids;
+
+        SaveData() {
+            std::string store(ModDataStoreFormat::STORE_HEADER);
+            for (size_t i = 0; i < MOD_COUNT; i += 1) {
+                auto id = "developer" + std::to_string(i) + ".some-mod";
+                auto settings = R"({"enabled":true,"speed":1.5,"color":[255,128,0],"mode":"fast"})";
+                auto saved = R"({"last-opened":"2024-01-01","counter":)" + std::to_string(i) + "}";
+                dir.create("mods/" + id + "/settings.json", settings);
+                dir.create("mods/" + id + "/saved.json", saved);
+                ModDataStoreFormat::appendRecord(store, id, ModDataStoreFormat::Kind::Settings, settings);
+                ModDataStoreFormat::appendRecord(store, id, ModDataStoreFormat::Kind::SavedValues, saved);
+                ids.push_back(id);
+            }
+            dir.create("mod-data.bin", store);
+        }
+    };
+}
+
+// Same as file::readString
+static std::optional<std::string> readString(std::filesystem::path const& path) {
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    std::ifstream in(path.string(), std::ios::in | std::ios::binary);
+    if (!in) {
+        return std::nullopt;
+    }
+    std::string contents;
+    in.seekg(0, std::ios::end);
+    contents.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    in.read(&contents[0], contents.size());
+    return contents;
+}
+
+static void reportFileCalls(benchmark::State& state, FileProbe const& calls) {
+    state.counters["stat"] = benchmark::Counter(
+        static_cast<double>(calls.stat), benchmark::Counter::kAvgIterations
+    );
+    state.counters["open"] = benchmark::Counter(
+        static_cast<double>(calls.open), benchmark::Counter::kAvgIterations
+    );
+}
+
+// Mod::Impl::loadData's steps for getting every mod's data as strings. 
+// Parsing the JSON afterwards is the same for both, so it's left out
+
+static void BM_LoadDataFiles(benchmark::State& state) {
+    SaveData data;
+    auto before = FileProbe::get();
+    for (auto _ : state) {
+        for (auto& id : data.ids) {
+            auto dir = data.dir.path / "mods" / id;
+            std::optional<std::string> settings;
+            std::optional<std::string> saved;
+            if (std::filesystem::exists(dir / "settings.json")) {
+                settings = readString(dir / "settings.json");
+            }
+            if (std::filesystem::exists(dir / "saved.json")) {
+                saved = readString(dir / "saved.json");
+            }
+            benchmark::DoNotOptimize(settings);
+            benchmark::DoNotOptimize(saved);
+        }
+    }
+    reportFileCalls(state, FileProbe::get() - before);
+}
+BENCHMARK(BM_LoadDataFiles)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadDataStore(benchmark::State& state) {
+    SaveData data;
+    auto before = FileProbe::get();
+    for (auto _ : state) {
+        ModDataStoreFormat::Entries entries;
+        if (auto store = readString(data.dir.path / "mod-data.bin")) {
+            if (!ModDataStoreFormat::parse(*store, entries)) {
+                state.SkipWithError("Store didn't parse");
+            }
+        }
+        for (auto& id : data.ids) {
+            auto it = entries.find(id);
+            if (it != entries.end()) {
+                benchmark::DoNotOptimize(it->second.settings);
+                benchmark::DoNotOptimize(it->second.savedValues);
+            }
+        }
+    }
+    reportFileCalls(state, FileProbe::get() - before);
+}
+BENCHMARK(BM_LoadDataStore)->Unit(benchmark::kMillisecond);
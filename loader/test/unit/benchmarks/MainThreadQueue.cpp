@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <loader/MainThreadQueue.hpp>
+
+using namespace geode;
+
+// Stands in for a queued function doing some actual work, such as posting 
+// an event to a few listeners
+static void work() {
+    auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+    while (std::chrono::steady_clock::now() < end) {}
+}
+
+// Queueing from a thread while the main thread isn't running the queue
+static void BM_MainThreadQueuePush(benchmark::State& state) {
+    MainThreadQueue queue;
+    size_t count = 0;
+    for (auto _ : state) {
+        queue.push([] {}, MainThreadPriority::Normal);
+        // Keep the queue from growing forever
+        if (++count == 10000) {
+            state.PauseTiming();
+            queue.execute();
+            count = 0;
+            state.ResumeTiming();
+        }
+    }
+}
+BENCHMARK(BM_MainThreadQueuePush);
+
+// A frame's worth of functions with no budget
+static void BM_MainThreadQueueFrame(benchmark::State& state) {
+    MainThreadQueue queue;
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i += 1) {
+            queue.push([] {}, MainThreadPriority::Normal);
+        }
+        queue.execute();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MainThreadQueueFrame)->Arg(1)->Arg(1000);
+
+// Draining a burst of functions that take longer than a frame's budget in 
+// total, such as a lot of tasks finishing at once. This is how many 
+// functions the queue gets through per second when it has to check the 
+// budget before each one, and how many frames that takes
+static void BM_MainThreadQueueBudget(benchmark::State& state) {
+    MainThreadQueue queue;
+    queue.setBudget(std::chrono::microseconds(state.range(0)));
+    size_t frames = 0;
+    for (auto _ : state) {
+        size_t runs = 0;
+        for (size_t i = 0; i < 1000; i += 1) {
+            queue.push([&] {
+                work();
+                runs += 1;
+            }, MainThreadPriority::Normal);
+        }
+        while (runs < 1000) {
+            queue.execute();
+            frames += 1;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+    state.SetLabel("frames: " + std::to_string(frames / state.iterations()));
+}
+BENCHMARK(BM_MainThreadQueueBudget)->Arg(500)->Arg(4000)->Unit(benchmark::kMillisecond);
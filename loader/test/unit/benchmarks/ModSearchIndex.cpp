@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+#include <ui/mods/sources/ModSearchIndex.hpp>
+#include "AllocationProbe.hpp"
+#include <optional>
+
+// A lot of installed mods, to see how search scales with them
+static constexpr size_t MOD_COUNT = 1000;
+
+namespace {
+    // The parts of a mod's metadata that search looks at
+    struct Metadata final {
+        std::string name;
+        std::string id;
+        std::vector<std::string> developers;
+        std::optional<std::string> description;
+        std::optional<std::string> details;
+        std::unordered_set<std::string> tags;
+    };
+}
+
+static std::vector<Metadata> makeMetadata(size_t count) {
+    std::vector<Metadata> mods;
+    for (size_t i = 0; i < count; i += 1) {
+        auto num = std::to_string(i);
+        mods.push_back(Metadata {
+            .name = "Mod Number " + num,
+            .id = "developer" + num + ".mod-number-" + num,
+            .developers = { "Developer " + num },
+            .description = "A mod that changes some things about the game",
+            .details = "# Mod Number " + num + "\n\nThis mod changes some things about the game. "
+                "It has a few settings to configure which things it changes and how.",
+            .tags = { "gameplay", "interface" },
+        });
+    }
+    return mods;
+}
+
+// Entries shaped like the ones built for installed mods. Details are only 
+// indexed once a search needs them
+static std::vector<ModSearchIndex::Entry> makeEntries(std::vector<Metadata> const& mods, bool withDetails = true) {
+    std::vector<ModSearchIndex::Entry> entries;
+    entries.reserve(mods.size());
+    for (auto& mod : mods) {
+        ModSearchIndex::Entry entry;
+        entry.name = mod.name;
+        entry.tags = mod.tags;
+        ModSearchIndex::addField(entry, mod.name, 1);
+        ModSearchIndex::addField(entry, mod.id, 0.5);
+        for (auto& dev : mod.developers) {
+            ModSearchIndex::addField(entry, dev, 0.25);
+        }
+        ModSearchIndex::addField(entry, *mod.description, 0.02);
+        if (withDetails) {
+            ModSearchIndex::addField(entry, *mod.details, 0.005);
+            entry.hasDetails = true;
+        }
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+// How search worked before the index: every query copied each mod's
+// metadata and fuzzy matched all of its fields
+static bool linearFuzzyMatch(Metadata const& mod, std::string const& kw, double& weighted) {
+    auto metadata = mod;
+    bool addToList = false;
+    addToList |= weightedFuzzyMatch(metadata.name, kw, 1, weighted);
+    addToList |= weightedFuzzyMatch(metadata.id, kw, 0.5, weighted);
+    for (auto& dev : metadata.developers) {
+        addToList |= weightedFuzzyMatch(dev, kw, 0.25, weighted);
+    }
+    if (metadata.details) {
+        addToList |= weightedFuzzyMatch(*metadata.details, kw, 0.005, weighted);
+    }
+    if (metadata.description) {
+        addToList |= weightedFuzzyMatch(*metadata.description, kw, 0.02, weighted);
+    }
+    if (weighted < 2) {
+        addToList = false;
+    }
+    return addToList;
+}
+
+static char const* QUERIES[] = { "number 42", "mod", "qz" };
+
+static void BM_SearchQuery(benchmark::State& state) {
+    auto entries = makeEntries(makeMetadata(MOD_COUNT));
+    auto text = QUERIES[state.range(0)];
+    auto query = ModSearchIndex::createQuery(text);
+    state.SetLabel(text);
+    for (auto _ : state) {
+        size_t matches = 0;
+        for (auto& entry : entries) {
+            double weighted = 0;
+            matches += modFuzzyMatch(entry, query, weighted);
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+}
+BENCHMARK(BM_SearchQuery)->DenseRange(0, 2);
+
+static void BM_SearchQueryLinear(benchmark::State& state) {
+    auto mods = makeMetadata(MOD_COUNT);
+    std::string text = QUERIES[state.range(0)];
+    state.SetLabel(text);
+    for (auto _ : state) {
+        size_t matches = 0;
+        for (auto& mod : mods) {
+            double weighted = 0;
+            matches += linearFuzzyMatch(mod, text, weighted);
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+}
+BENCHMARK(BM_SearchQueryLinear)->DenseRange(0, 2);
+
+static void BM_SearchBuildEntries(benchmark::State& state) {
+    auto mods = makeMetadata(MOD_COUNT);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(makeEntries(mods));
+    }
+}
+BENCHMARK(BM_SearchBuildEntries);
+
+// How much memory the index holds for a lot of mods, which the mod list 
+// keeps around for as long as it's open
+static void BM_SearchEntriesMemory(benchmark::State& state) {
+    auto mods = makeMetadata(500);
+    bool withDetails = state.range(0);
+    AllocationProbe held;
+    for (auto _ : state) {
+        auto before = AllocationProbe::get();
+        auto entries = makeEntries(mods, withDetails);
+        held = AllocationProbe::get() - before;
+        benchmark::DoNotOptimize(entries);
+    }
+    state.SetLabel(withDetails ? "with details" : "without details");
+    state.counters["bytes"] = static_cast<double>(held.live);
+    state.counters["allocations"] = static_cast<double>(held.allocations);
+}
+BENCHMARK(BM_SearchEntriesMemory)->Arg(0)->Arg(1);
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+#include <cocos2d-ext/ResourceIndex.hpp>
+#include "FileProbe.hpp"
+#include "TempDir.hpp"
+
+using namespace geode;
+
+namespace {
+    // The game's resources after a lot of extracted mods, which is where
+    // cocos would have to stat every mod's directory to find a game file.
+    // That's 300 search paths: one per mod, then the game's resources
+    struct Resources final {
+        TempDir dir;
+        std::vector<std::string> searchPaths;
+
+        Resources() {
+            for (size_t i = 0; i < 299; i += 1) {
+                auto mod = "mod" + std::to_string(i);
+                for (size_t j = 0; j < 20; j += 1) {
+                    dir.create("runtime/" + mod + "/resources/" + mod + "_" + std::to_string(j) + ".png");
+                }
+                searchPaths.push_back((dir.path / "runtime" / mod / "resources" / "").string());
+            }
+            dir.create("resources/GJ_GameSheet.png");
+            searchPaths.push_back((dir.path / "resources" / "").string());
+        }
+
+        // Creating the files takes far longer than any of the benchmarks,
+        // so they all share them
+        static Resources const& get() {
+            static Resources res;
+            return res;
+        }
+    };
+}
+
+// How cocos finds a file without the index: checking whether it exists in
+// each search path in order, which is a stat each
+static std::optional<std::string> lookupUnindexed(std::vector<std::string> const& searchPaths, std::string const& file) {
+    for (auto& dir : searchPaths) {
+        auto path = dir + file;
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(path, ec)) {
+            return path;
+        }
+    }
+    return std::nullopt;
+}
+
+static void reportFileCalls(benchmark::State& state, FileProbe const& calls) {
+    state.counters["stat"] = benchmark::Counter(
+        static_cast<double>(calls.stat), benchmark::Counter::kAvgIterations
+    );
+    state.counters["open"] = benchmark::Counter(
+        static_cast<double>(calls.open), benchmark::Counter::kAvgIterations
+    );
+}
+
+static void BM_ResourceLookup(benchmark::State& state, std::string const& file) {
+    auto& res = Resources::get();
+    ResourceIndex index(res.dir.path / "runtime");
+    if (!index.lookup(res.searchPaths, "mod50_3.png")) {
+        state.SkipWithError("Index didn't find a mod file");
+        return;
+    }
+    auto before = FileProbe::get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.lookup(res.searchPaths, file));
+    }
+    reportFileCalls(state, FileProbe::get() - before);
+}
+BENCHMARK_CAPTURE(BM_ResourceLookup, ModFile, "mod50_3.png");
+BENCHMARK_CAPTURE(BM_ResourceLookup, GameFile, "GJ_GameSheet.png");
+BENCHMARK_CAPTURE(BM_ResourceLookup, MissingFile, "missing.png");
+
+static void BM_ResourceLookupUnindexed(benchmark::State& state, std::string const& file) {
+    auto& res = Resources::get();
+    auto before = FileProbe::get();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lookupUnindexed(res.searchPaths, file));
+    }
+    reportFileCalls(state, FileProbe::get() - before);
+}
+BENCHMARK_CAPTURE(BM_ResourceLookupUnindexed, ModFile, "mod50_3.png");
+BENCHMARK_CAPTURE(BM_ResourceLookupUnindexed, GameFile, "GJ_GameSheet.png");
+BENCHMARK_CAPTURE(BM_ResourceLookupUnindexed, MissingFile, "missing.png");
+
+// Search paths are added one at a time while mods load, and each change 
+// rebuilds the index. Directories that were already scanned aren't again
+static void BM_ResourceIndexRebuild(benchmark::State& state) {
+    auto& res = Resources::get();
+    ResourceIndex index(res.dir.path / "runtime");
+    benchmark::DoNotOptimize(index.lookup(res.searchPaths, "mod50_3.png"));
+    auto before = FileProbe::get();
+    for (auto _ : state) {
+        index.invalidate();
+        benchmark::DoNotOptimize(index.lookup(res.searchPaths, "mod50_3.png"));
+    }
+    reportFileCalls(state, FileProbe::get() - before);
+}
+BENCHMARK(BM_ResourceIndexRebuild);
+
+// Building the index from scratch, which scans every mod's directory
+static void BM_ResourceIndexBuild(benchmark::State& state) {
+    auto& res = Resources::get();
+    auto before = FileProbe::get();
+    for (auto _ : state) {
+        ResourceIndex index(res.dir.path / "runtime");
+        benchmark::DoNotOptimize(index.lookup(res.searchPaths, "mod50_3.png"));
+    }
+    reportFileCalls(state, FileProbe::get() - before);
+}
+BENCHMARK(BM_ResourceIndexBuild);
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <utils/safeWrite.hpp>
+#include "TempDir.hpp"
+#include <fstream>
+
+// Saving the game with a lot of mods installed, out of which only a few 
+// changed anything since the last save
+static constexpr size_t MOD_COUNT = 300;
+static constexpr size_t DIRTY_COUNT = 5;
+
+namespace {
+    // The parts of a mod that saving looks at. The JSON is kept already 
+    // dumped, since dumping it costs the same whether the file is written or 
+    // not; what differs is how many mods get to that point at all
+    struct ModData final {
+        std::filesystem::path saveDir;
+        std::string settings;
+        std::string saved;
+        bool settingsChanged = false;
+        bool savedChanged = false;
+        size_t lastSettingsHash = 0;
+        size_t lastSavedHash = 0;
+    };
+
+    struct Mods final {
+        TempDir dir;
+        std::vector<ModData> mods;
+        size_t saves = 0;
+
+        Mods() {
+            for (size_t i = 0; i < MOD_COUNT; i += 1) {
+                auto id = "developer" + std::to_string(i) + ".some-mod";
+                auto saveDir = dir.path / id;
+                std::filesystem::create_directories(saveDir);
+                mods.push_back(ModData {
+                    .saveDir = saveDir,
+                    .settings = R"({"enabled":true,"speed":1.5,"color":[255,128,0],"mode":"fast"})",
+                    .saved = R"({"last-opened":"2024-01-01","counter":0,"seen-popup":true})",
+                });
+            }
+        }
+
+        // Some mods change their saved values, like they would during play
+        void play() {
+            saves += 1;
+            for (size_t i = 0; i < DIRTY_COUNT; i += 1) {
+                auto& mod = mods[i * (MOD_COUNT / DIRTY_COUNT)];
+                // Same size every time, so that the bytes written don't 
+                // depend on how many iterations the benchmark runs
+                mod.saved = R"({"last-opened":"2024-01-01","counter":)" + std::to_string(saves % 2) + "}";
+                mod.savedChanged = true;
+            }
+        }
+    };
+}
+
+static void reportWrites(benchmark::State& state, size_t files, size_t bytes) {
+    state.counters["files"] = benchmark::Counter(
+        static_cast<double>(files), benchmark::Counter::kAvgIterations
+    );
+    state.counters["bytes"] = benchmark::Counter(
+        static_cast<double>(bytes), benchmark::Counter::kAvgIterations
+    );
+}
+
+// How saving used to work: both files of every mod were rewritten in place
+static void BM_SaveDataAll(benchmark::State& state) {
+    Mods mods;
+    size_t files = 0;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        mods.play();
+        state.ResumeTiming();
+
+        for (auto& mod : mods.mods) {
+            for (auto& [name, data] : { std::pair { "settings.json", &mod.settings }, { "saved.json", &mod.saved } }) {
+                std::ofstream(mod.saveDir / name, std::ios::binary) << *data;
+                files += 1;
+                bytes += data->size();
+            }
+        }
+    }
+    reportWrites(state, files, bytes);
+}
+BENCHMARK(BM_SaveDataAll)->Unit(benchmark::kMillisecond);
+
+// How Mod::Impl::serializeData works now: only data that's been marked 
+// changed is looked at, and only written if it hashes differently from the 
+// last write. Writes go through writeStringSafe, which also syncs them to 
+// disk so they can't be lost halfway through
+static void BM_SaveDataChanged(benchmark::State& state) {
+    Mods mods;
+    size_t files = 0;
+    size_t bytes = 0;
+    auto save = [&](ModData& mod, char const* name, std::string const& data, size_t& lastHash) {
+        auto hash = std::hash<std::string>()(data);
+        if (hash == lastHash) {
+            return;
+        }
+        lastHash = hash;
+        if (auto err = geode::utils::file::platformWriteSafe(mod.saveDir / name, data)) {
+            state.SkipWithError(err);
+        }
+        files += 1;
+        bytes += data.size();
+    };
+    for (auto _ : state) {
+        state.PauseTiming();
+        mods.play();
+        state.ResumeTiming();
+
+        for (auto& mod : mods.mods) {
+            if (mod.settingsChanged) {
+                mod.settingsChanged = false;
+                save(mod, "settings.json", mod.settings, mod.lastSettingsHash);
+            }
+            if (mod.savedChanged) {
+                mod.savedChanged = false;
+                save(mod, "saved.json", mod.saved, mod.lastSavedHash);
+            }
+        }
+    }
+    reportWrites(state, files, bytes);
+}
+BENCHMARK(BM_SaveDataChanged)->Unit(benchmark::kMillisecond);
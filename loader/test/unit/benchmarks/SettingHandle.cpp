@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <Geode/loader/SettingHandle.hpp>
+#include <Geode/platform/platform.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+using namespace geode;
+
+// About as many settings as a mod with a lot of them has
+static constexpr size_t SETTING_COUNT = 30;
+
+namespace {
+    // Stand in for SettingV3 and its subclasses, which need cocos for their 
+    // nodes. Reading a value only needs the class hierarchy for the cast
+    class FakeSettingBase {
+    public:
+        virtual ~FakeSettingBase() = default;
+    };
+    template <class T>
+    class FakeSetting final : public FakeSettingBase {
+    public:
+        T value;
+        FakeSetting(T value) : value(std::move(value)) {}
+        T const& getValueRef() const {
+            return value;
+        }
+        T getValue() const {
+            return value;
+        }
+    };
+
+    // How Mod::getSettingValue gets to a setting: a lookup by key in 
+    // ModSettingsManager's map, which gives a copy of the shared pointer, 
+    // which is then cast to the setting's type before copying its value out
+    class FakeSettings final {
+        std::unordered_map<std::string, std::shared_ptr<FakeSettingBase>> m_settings;
+
+    public:
+        template <class T>
+        FakeSettings(T value) {
+            for (size_t i = 0; i < SETTING_COUNT; i += 1) {
+                m_settings.emplace(
+                    "some-setting-" + std::to_string(i), std::make_shared<FakeSetting<T>>(value)
+                );
+            }
+        }
+
+        std::shared_ptr<FakeSettingBase> get(std::string_view key) {
+            auto it = m_settings.find(std::string(key));
+            return it != m_settings.end() ? it->second : nullptr;
+        }
+        template <class T>
+        T getSettingValue(std::string_view key) {
+            if (auto sett = cast::typeinfo_pointer_cast<FakeSetting<T>>(this->get(key))) {
+                return sett->getValue();
+            }
+            return T();
+        }
+        template <class T>
+        SettingHandle<T, FakeSetting<T>> getSettingHandle(std::string_view key) {
+            return cast::typeinfo_pointer_cast<FakeSetting<T>>(this->get(key));
+        }
+    };
+}
+
+template <class T>
+static void BM_SettingLookup(benchmark::State& state, T value) {
+    FakeSettings settings(value);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(settings.getSettingValue<T>("some-setting-20"));
+    }
+}
+BENCHMARK_CAPTURE(BM_SettingLookup, Bool, true);
+BENCHMARK_CAPTURE(BM_SettingLookup, String, std::string("A string that's too long for SSO"));
+
+template <class T>
+static void BM_SettingHandle(benchmark::State& state, T value) {
+    FakeSettings settings(value);
+    auto handle = settings.getSettingHandle<T>("some-setting-20");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(handle.get());
+    }
+}
+BENCHMARK_CAPTURE(BM_SettingHandle, Bool, true);
+BENCHMARK_CAPTURE(BM_SettingHandle, String, std::string("A string that's too long for SSO"));
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+#include <Geode/loader/Loader.hpp>
+#include <Geode/utils/Task.hpp>
+#include <Runtime.hpp>
+#include <future>
+
+using namespace geode::prelude;
+
+namespace {
+    using IntTask = Task<int, int>;
+
+    // A task that stays pending until the benchmark finishes it or posts 
+    // progress from its own thread, so that what's measured is the cost of 
+    // getting the values to the listener and not of the task's thread
+    struct PendingTask final {
+        IntTask task;
+        IntTask::PostResult finish;
+        IntTask::PostProgress progress;
+
+        PendingTask() {
+            auto callbacks = std::make_shared<
+                std::promise<std::pair<IntTask::PostResult, IntTask::PostProgress>>
+            >();
+            auto future = callbacks->get_future();
+            task = IntTask::runWithCallback([callbacks](auto finish, auto progress, auto) {
+                callbacks->set_value({ std::move(finish), std::move(progress) });
+            });
+            std::tie(finish, progress) = future.get();
+        }
+    };
+}
+
+// Benchmarks that start a task's thread on every iteration don't count that 
+// time, but still spend it, so they'd run for far too long otherwise
+static constexpr benchmark::IterationCount ITERATIONS_WITH_THREADS = 20000;
+
+// A task that reports progress far more often than frames happen, like a 
+// download does. Only the latest value is posted on each frame
+static void BM_TaskProgress(benchmark::State& state) {
+    PendingTask pending;
+    size_t events = 0;
+    EventListener<IntTask> listener([&](IntTask::Event* event) {
+        events += event->getProgress() != nullptr;
+    }, pending.task);
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i += 1) {
+            pending.progress(i);
+        }
+        host::runMainThreadQueue();
+    }
+    state.counters["events_per_frame"] = benchmark::Counter(
+        static_cast<double>(events) / state.iterations()
+    );
+    pending.finish(0);
+    host::runMainThreadQueue();
+}
+BENCHMARK(BM_TaskProgress)->Arg(1)->Arg(100);
+
+// Finishing a task until its listener gets the value
+static void BM_TaskFinish(benchmark::State& state) {
+    size_t frames = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PendingTask pending;
+        bool done = false;
+        EventListener<IntTask> listener([&](IntTask::Event* event) {
+            done = event->getValue() != nullptr;
+        }, pending.task);
+        state.ResumeTiming();
+
+        pending.finish(1);
+        while (!done) {
+            host::runMainThreadQueue();
+            frames += 1;
+        }
+    }
+    state.counters["frames"] = benchmark::Counter(
+        static_cast<double>(frames) / state.iterations()
+    );
+}
+BENCHMARK(BM_TaskFinish)->Iterations(ITERATIONS_WITH_THREADS);
+
+// Finishing a task that's mapped a few times, like a web request whose 
+// response is checked, parsed and then converted, until the listener at 
+// the end of the chain gets the value. Counts how many frames that takes 
+// and how many functions it queues to the main thread
+static void BM_TaskMapChain(benchmark::State& state, TaskExecutor executor) {
+    size_t frames = 0;
+    size_t queued = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PendingTask pending;
+        auto mapped = pending.task;
+        for (size_t i = 0; i < 3; i += 1) {
+            mapped = mapped.mapOn(executor, [](int* value) { return *value + 1; });
+        }
+        bool done = false;
+        EventListener<IntTask> listener([&](IntTask::Event* event) {
+            done = event->getValue() != nullptr;
+        }, mapped);
+        auto queuedBefore = host::getMainThreadQueuedCount();
+        state.ResumeTiming();
+
+        pending.finish(1);
+        while (!done) {
+            host::runMainThreadQueue();
+            frames += 1;
+        }
+
+        state.PauseTiming();
+        queued += host::getMainThreadQueuedCount() - queuedBefore;
+        state.ResumeTiming();
+    }
+    state.counters["frames"] = benchmark::Counter(
+        static_cast<double>(frames) / state.iterations()
+    );
+    state.counters["queued"] = benchmark::Counter(
+        static_cast<double>(queued) / state.iterations()
+    );
+}
+BENCHMARK_CAPTURE(BM_TaskMapChain, MainThread, TaskExecutor::MainThread)->Iterations(ITERATIONS_WITH_THREADS);
+BENCHMARK_CAPTURE(BM_TaskMapChain, Background, TaskExecutor::Background)->Iterations(ITERATIONS_WITH_THREADS);
+
+// Creating an already finished task and getting its value to a listener
+static void BM_TaskImmediate(benchmark::State& state) {
+    for (auto _ : state) {
+        int value = 0;
+        EventListener<IntTask> listener([&](IntTask::Event* event) {
+            value = *event->getValue();
+        }, IntTask::immediate(1));
+        host::runMainThreadQueue();
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_TaskImmediate);
@@ -0,0 +1,94 @@
+import argparse
+import json
+import sys
+
+# Compares a run of GeodeBenchmarks against the checked in baseline:
+#   GeodeBenchmarks --benchmark_out=results.json --benchmark_out_format=json
+#   python3 compare.py baseline.json results.json
+#
+# Times vary a lot between machines (CI runners aren't the machine the
+# baseline was recorded on), so they only fail the comparison when they get
+# a lot slower. Rates like items_per_second are derived from the times, so
+# they aren't compared at all. Other counters are things like syscalls,
+# allocated bytes or frames, which are the same on every machine and where
+# lower is better, so they fail the comparison as soon as they go up at all.
+#
+# To update the baseline after a change that's expected to move the numbers,
+# run the benchmarks from a release build and copy the output over
+# baseline.json
+
+# Fields of a benchmark in the output that aren't counters
+fields = {
+    "name", "family_index", "per_family_instance_index", "run_name", "run_type",
+    "repetitions", "repetition_index", "threads", "iterations", "real_time",
+    "cpu_time", "time_unit", "label", "error_occurred", "error_message",
+    "aggregate_name", "aggregate_unit",
+}
+
+units = {
+    "ns": 1,
+    "us": 1e3,
+    "ms": 1e6,
+    "s": 1e9,
+}
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+    return {
+        b["name"]: b for b in results["benchmarks"]
+        if b.get("run_type", "iteration") == "iteration"
+    }
+
+def cpu_time(bench):
+    return bench["cpu_time"] * units[bench.get("time_unit", "ns")]
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("results")
+    parser.add_argument(
+        "--max-slowdown", type=float, default=2.0,
+        help="how many times slower than the baseline a benchmark may be"
+    )
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    results = load(args.results)
+    failures = []
+
+    for name, base in baseline.items():
+        res = results.get(name)
+        if res is None:
+            failures.append(f"{name}: missing from the results")
+            continue
+        if res.get("error_occurred"):
+            failures.append(f"{name}: {res.get('error_message')}")
+            continue
+
+        ratio = cpu_time(res) / cpu_time(base)
+        print(f"{name}: {ratio:.2f}x the baseline's time")
+        if ratio > args.max_slowdown:
+            failures.append(f"{name}: {ratio:.2f}x slower than the baseline")
+
+        for counter, value in base.items():
+            if counter in fields or counter.endswith("_per_second"):
+                continue
+            current = res.get(counter)
+            if current is None:
+                failures.append(f"{name}: counter '{counter}' is missing")
+            elif current > value * (1 + 1e-6):
+                failures.append(f"{name}: counter '{counter}' went from {value} to {current}")
+
+    for name in results.keys() - baseline.keys():
+        print(f"{name}: not in the baseline yet")
+
+    if failures:
+        print("\nFailed:")
+        for failure in failures:
+            print(f"  {failure}")
+        return 1
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
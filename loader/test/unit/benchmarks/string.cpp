@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <Geode/utils/string.hpp>
+
+using namespace geode::prelude;
+
+// Roughly the size of a mod's description
+static std::string makeText() {
+    std::string text;
+    for (size_t i = 0; i < 64; i += 1) {
+        text += "Some Mixed Case Words, ";
+    }
+    return text;
+}
+
+static void BM_Split(benchmark::State& state) {
+    auto text = makeText();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::string::split(text, ", ").size());
+    }
+}
+BENCHMARK(BM_Split);
+
+static void BM_SplitView(benchmark::State& state) {
+    auto text = makeText();
+    for (auto _ : state) {
+        size_t count = 0;
+        for (auto part : utils::string::splitView(text, ", ")) {
+            count += part.size();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(BM_SplitView);
+
+static void BM_ToLower(benchmark::State& state) {
+    auto text = makeText();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::string::toLower(text));
+    }
+}
+BENCHMARK(BM_ToLower);
+
+static void BM_ToUpper(benchmark::State& state) {
+    auto text = makeText();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::string::toUpper(text));
+    }
+}
+BENCHMARK(BM_ToUpper);
+
+static void BM_CaseInsensitiveEquals(benchmark::State& state) {
+    auto text = makeText();
+    auto upper = utils::string::toUpper(text);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::string::caseInsensitiveEquals(text, upper));
+    }
+}
+BENCHMARK(BM_CaseInsensitiveEquals);
+
+static void BM_CaseInsensitiveCompare(benchmark::State& state) {
+    auto text = makeText();
+    auto upper = utils::string::toUpper(text);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::string::caseInsensitiveCompare(text, upper));
+    }
+}
+BENCHMARK(BM_CaseInsensitiveCompare);
+
+static void BM_CaseInsensitiveHash(benchmark::State& state) {
+    auto text = makeText();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(utils::string::caseInsensitiveHash(text));
+    }
+}
+BENCHMARK(BM_CaseInsensitiveHash);
@@ -0,0 +1,56 @@
+#include <catch2/catch.hpp>
+#include <utils/safeWrite.hpp>
+#include "TempDir.hpp"
+#include <sstream>
+
+using namespace geode::prelude;
+
+static std::string read(std::filesystem::path const& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+TEST_CASE("Safe writes create the file") {
+    TempDir dir;
+    auto path = dir.path / "data.json";
+    CHECK(utils::file::platformWriteSafe(path, "{\"a\":1}") == nullptr);
+    CHECK(read(path) == "{\"a\":1}");
+    CHECK(dir.fileCount() == 1);
+}
+
+TEST_CASE("Safe writes replace existing contents") {
+    TempDir dir;
+    auto path = dir.path / "data.json";
+    REQUIRE(utils::file::platformWriteSafe(path, std::string(4096, 'x')) == nullptr);
+    CHECK(utils::file::platformWriteSafe(path, "short") == nullptr);
+    CHECK(read(path) == "short");
+    CHECK(utils::file::platformWriteSafe(path, "") == nullptr);
+    CHECK(read(path).empty());
+    CHECK(dir.fileCount() == 1);
+}
+
+TEST_CASE("Safe writes keep binary data intact") {
+    TempDir dir;
+    auto path = dir.path / "data.bin";
+    std::string data;
+    for (int i = 0; i < 1024; i += 1) {
+        data.push_back(static_cast<char>(i % 256));
+    }
+    CHECK(utils::file::platformWriteSafe(path, data) == nullptr);
+    CHECK(read(path) == data);
+}
+
+TEST_CASE("Safe writes fail without leaving anything behind") {
+    TempDir dir;
+    CHECK(utils::file::platformWriteSafe(dir.path / "missing" / "data.json", "{}") != nullptr);
+    CHECK(dir.fileCount() == 0);
+
+    // The temporary file can be written, but it can't be moved over a 
+    // directory, so it needs to be cleaned up
+    std::filesystem::create_directory(dir.path / "dir");
+    std::filesystem::create_directory(dir.path / "dir" / "child");
+    CHECK(utils::file::platformWriteSafe(dir.path / "dir", "{}") != nullptr);
+    CHECK(dir.fileCount() == 1);
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch.hpp>
+#include <Geode/utils/string.hpp>
+#include <algorithm>
+
+using namespace geode::prelude;
+
+static std::vector<std::string> collect(std::string_view str, std::string_view separator) {
+    std::vector<std::string> res;
+    for (auto part : utils::string::splitView(str, separator)) {
+        res.emplace_back(part);
+    }
+    return res;
+}
+
+static char referenceLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+static char referenceUpper(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - ('a' - 'A')) : c;
+}
+
+TEST_CASE("splitView gives the parts between separators") {
+    CHECK(collect("a,b,c", ",") == std::vector<std::string> { "a", "b", "c" });
+    CHECK(collect("one::two", "::") == std::vector<std::string> { "one", "two" });
+    CHECK(collect("abc", ",") == std::vector<std::string> { "abc" });
+}
+
+TEST_CASE("splitView keeps empty parts") {
+    CHECK(collect(",a,,b,", ",") == std::vector<std::string> { "", "a", "", "b", "" });
+    CHECK(collect(",", ",") == std::vector<std::string> { "", "" });
+}
+
+TEST_CASE("splitView of an empty string is empty") {
+    CHECK(collect("", ",").empty());
+    auto view = utils::string::splitView("", ",");
+    CHECK(view.begin() == view.end());
+}
+
+TEST_CASE("splitView with an empty separator gives the whole string") {
+    CHECK(collect("abc", "") == std::vector<std::string> { "abc" });
+}
+
+TEST_CASE("splitView parts point into the original string") {
+    std::string_view str = "key=value";
+    auto it = utils::string::splitView(str, "=").begin();
+    CHECK((*it).data() == str.data());
+    ++it;
+    CHECK((*it).data() == str.data() + 4);
+    ++it;
+    CHECK(it == std::default_sentinel);
+}
+
+TEST_CASE("split matches splitView") {
+    for (auto str : { "", "a", "a/b/c", "/a//b/", "//" }) {
+        CHECK(utils::string::split(str, "/") == collect(str, "/"));
+    }
+}
+
+TEST_CASE("Case conversion only touches ASCII letters") {
+    CHECK(utils::string::toLower("Hello, World! 123") == "hello, world! 123");
+    CHECK(utils::string::toUpper("Hello, World! 123") == "HELLO, WORLD! 123");
+    // The characters right outside the letter ranges
+    CHECK(utils::string::toLower("@[`{") == "@[`{");
+    CHECK(utils::string::toUpper("@[`{") == "@[`{");
+    // UTF-8 multibyte characters are left alone
+    CHECK(utils::string::toLower("\xC3\x84pfel") == "\xC3\x84pfel");
+    CHECK(utils::string::toUpper("\xC3\xA4pfel") == "\xC3\xA4PFEL");
+}
+
+TEST_CASE("Case conversion matches a byte by byte conversion") {
+    // Every byte value at every offset, so each one goes through both the
+    // eight byte wide path and the path for the tail
+    std::string all;
+    for (int c = 0; c < 256; c += 1) {
+        all.push_back(static_cast<char>(c));
+    }
+    for (size_t offset = 0; offset < 8; offset += 1) {
+        auto str = std::string(offset, 'x') + all;
+        auto lower = str;
+        auto upper = str;
+        std::transform(lower.begin(), lower.end(), lower.begin(), referenceLower);
+        std::transform(upper.begin(), upper.end(), upper.begin(), referenceUpper);
+        CHECK(utils::string::toLower(str) == lower);
+        CHECK(utils::string::toUpper(str) == upper);
+    }
+}
+
+TEST_CASE("Case conversion in place returns the same string") {
+    std::string str = "MiXeD";
+    CHECK(&utils::string::toLowerIP(str) == &str);
+    CHECK(str == "mixed");
+    CHECK(&utils::string::toUpperIP(str) == &str);
+    CHECK(str == "MIXED");
+}
+
+TEST_CASE("Case-insensitive equality") {
+    CHECK(utils::string::caseInsensitiveEquals("", ""));
+    CHECK(utils::string::caseInsensitiveEquals("geode.loader", "Geode.Loader"));
+    CHECK(utils::string::caseInsensitiveEquals("SOME LONGER STRING!", "some longer string!"));
+    CHECK_FALSE(utils::string::caseInsensitiveEquals("abc", "abcd"));
+    CHECK_FALSE(utils::string::caseInsensitiveEquals("some longer string", "some longer strinG?"));
+    // '@' and '`' differ only by 0x20 but aren't letters
+    CHECK_FALSE(utils::string::caseInsensitiveEquals("@@@@@@@@", "````````"));
+    CHECK_FALSE(utils::string::caseInsensitiveEquals("[", "{"));
+}
+
+TEST_CASE("Case-insensitive comparison") {
+    CHECK(utils::string::caseInsensitiveCompare("abc", "ABC") == std::strong_ordering::equal);
+    CHECK(utils::string::caseInsensitiveCompare("abc", "ABD") == std::strong_ordering::less);
+    CHECK(utils::string::caseInsensitiveCompare("B", "a") == std::strong_ordering::greater);
+    CHECK(utils::string::caseInsensitiveCompare("ab", "ABC") == std::strong_ordering::less);
+    CHECK(utils::string::caseInsensitiveCompare("abc", "AB") == std::strong_ordering::greater);
+}
+
+TEST_CASE("Case-insensitive hashes agree with equality") {
+    CHECK(utils::string::caseInsensitiveHash("Geode.Loader") == utils::string::caseInsensitiveHash("geode.loader"));
+    CHECK(utils::string::caseInsensitiveHash("A LONGER STRING THAN EIGHT") == utils::string::caseInsensitiveHash("a longer string than eight"));
+    CHECK(utils::string::caseInsensitiveHash("abc") != utils::string::caseInsensitiveHash("abd"));
+}
@@ -0,0 +1,67 @@
+#include "Runtime.hpp"
+#include <Geode/loader/Loader.hpp>
+#include <loader/MainThreadQueue.hpp>
+#include <Geode/utils/general.hpp>
+#include <Geode/utils/terminate.hpp>
+#include <atomic>
+#include <cstdio>
+
+using namespace geode::prelude;
+
+class Loader::Impl {
+public:
+    MainThreadQueue m_mainThreadQueue;
+    std::atomic_size_t m_queuedCount = 0;
+};
+
+// Named like the real one so that it gets Loader's friendship
+class geode::LoaderImpl {
+public:
+    static Loader::Impl* get() {
+        return Loader::get()->m_impl.get();
+    }
+};
+
+static thread_local std::string s_threadName;
+
+Loader::Loader() : m_impl(std::make_unique<Impl>()) {}
+Loader::~Loader() = default;
+
+Loader* Loader::get() {
+    // Never destroyed, like the real one
+    static auto loader = new Loader();
+    return loader;
+}
+
+// There are no mods on the host, so events are posted without a sender
+Mod* geode::getMod() {
+    return nullptr;
+}
+
+void Loader::queueInMainThread(ScheduledFunction&& func) {
+    this->queueInMainThread(std::move(func), MainThreadPriority::Normal);
+}
+void Loader::queueInMainThread(ScheduledFunction&& func, MainThreadPriority priority) {
+    m_impl->m_mainThreadQueue.push(std::move(func), priority);
+    m_impl->m_queuedCount += 1;
+}
+
+size_t host::runMainThreadQueue() {
+    auto impl = LoaderImpl::get();
+    impl->m_mainThreadQueue.execute();
+    return impl->m_mainThreadQueue.getStats().executed;
+}
+size_t host::getMainThreadQueuedCount() {
+    return LoaderImpl::get()->m_queuedCount;
+}
+
+std::string utils::thread::getName() {
+    return s_threadName;
+}
+void utils::thread::setName(std::string const& name) {
+    s_threadName = name;
+}
+
+void utils::detail::logTerminationError(char const* reason, Mod*) {
+    std::fprintf(stderr, "Terminating: %s\n", reason);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+// Host builds link the loader's sources without the loader itself, so the 
+// few loader functions they call into are stubbed out in Runtime.cpp. 
+// Nothing runs the main thread queue on its own; tests and benchmarks stand 
+// in for the game loop with these
+namespace geode::host {
+    /**
+     * Run the functions queued with queueInMainThread, like the loader does 
+     * once a frame. Functions queued while this runs wait for the next call
+     * @returns How many functions ran
+     */
+    size_t runMainThreadQueue();
+    /**
+     * How many functions have been queued with queueInMainThread so far
+     */
+    size_t getMainThreadQueuedCount();
+}
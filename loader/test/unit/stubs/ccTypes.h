@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Host builds don't have cocos. The loader's headers that get built for the 
+// host only need these types to be declared, apart from the colors which 
+// some settings hold by value
+namespace cocos2d {
+    struct ccColor3B {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+    };
+    struct ccColor4B {
+        uint8_t r;
+        uint8_t g;
+        uint8_t b;
+        uint8_t a;
+    };
+    struct ccColor4F {
+        float r;
+        float g;
+        float b;
+        float a;
+    };
+    class CCPoint;
+    class CCSize;
+    class CCRect;
+    class CCObject;
+    class CCArray;
+    class CCNode;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+// See ccTypes.h
+#include "ccTypes.h"
+
+namespace cocos2d {
+    class CCDictionary;
+    class CCString;
+    class CCSprite;
+    class CCMenuItem;
+    class CCLayer;
+    class CCScene;
+}